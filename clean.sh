@@ -19,10 +19,18 @@ rm -f tb/LOG
 rm -f tb/tr.vcd
 rm -f tb/tbsrc.vhd
 rm -f tb/tbsrc.sv
+rm -f tb/tbsrc.vec
 rm -f tb/*.out
+rm -rf tb/bench_results
+rm -f tb/golden/golden_bench
+rm -f tb/hwsim/hwsim
+rm -f tb/hwsim.link
+rm -f tb/replay/axi_replay
+rm -f tb/*.axi
 
 # Clean the 'sw' directory:
 rm -f sw/app.elf
+rm -f sw/bench/*.elf
 
 # Remove the automatically created 'VLSIProject' directory for the VivadoHLS project:
 rm -rf ./VLSIProject/solution1/.autopilot/
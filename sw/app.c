@@ -17,6 +17,15 @@
 #include "mmap.h"
 #include "isrsupport.h"
 #include "dbg_console.h"
+#include "sysctrl.h"
+#include "region.h"
+#include "dma.h"
+#include "sleep.h"
+#include "sw_baseline.h"
+#include "blkcopy.h"
+#include "timer.h"
+#include "ipring.h"
+#include "batch.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,8 +44,33 @@ uint32_t *RWNUM = (uint32_t *)SYS_RWNUM_RAM_BASE; // Example of a file for r/w
 
 int Iflag = 1; // Interruption flag
 
+static uint8_t sw_out[IPOUT_SIZE] __attribute__((aligned(4))); // Outputs of the software baseline
+
+// Code regions timed by the simulation (see region.h):
+#define REGION_LOAD      0 // Input data sent to the IP
+#define REGION_IRQ_WAIT  1 // Computation of the IP, until its interrupt
+#define REGION_DRAIN     2 // Output data read from the IP
+#define REGION_HW        3 // Whole use of the IP, from the load to the drain
+#define REGION_SW        4 // Same computation in software (see sw_baseline.h)
+#define REGION_BATCH     5 // Whole dataset in batch mode (see batch.h)
+
+#define APP_IP_TIMEOUT   1000000 // Cycles to wait for the interrupt of the IP (see timer.h)
+
+#ifdef APP_BATCH
+// Dataset of the batch mode: images of IPIN_SIZE bytes, one after the other in the memory
+// of rfile.txt (RFILE_SIZE words, see tb/top.cpp). Their outputs go to the memory of wfile.out:
+#define APP_BATCH_IMAGES (RFILE_SIZE * 4 / IPIN_SIZE)
+
+static batch_result_t batch_table[APP_BATCH_IMAGES]; // Results of the batch mode
+#endif
+
 int main()
 {
+    // The .data section is not reloaded by startup.s, so the flag and the state of the drivers
+    // are initialized again for every run (multi-run mode):
+    Iflag = 1;
+    dma_init();
+    timer_init();
 
     enableIRQ(); // Enable interruptions
 
@@ -56,13 +90,6 @@ int main()
         RWNUM[i] = aux;
     }
 
-    // Example code for reading a file mapped into the memory map and directly
-    // send its contents to a input port of an IP connected to the AXI bus:
-    for (i = 0; i < RFILE_SIZE; i++)
-    {
-        SYS_MEM32((SYS_AXI_BASE + IPIN_OFFSET + (4*i) )) = RFILE[i];
-    }
-
     // Example code for printing the data read from file:
     print_str("Read from the rfile.txt file:\n");
     for (i = 0; i < 20/* RFILE_SIZE*4 too long */; i++)
@@ -75,13 +102,34 @@ int main()
         print_char((char)RFILE[i]);
     }
 
-    // Example code of writing in an IP register a starting run flag:
-    SYS_MEM32((SYS_AXI_BASE ) ) = 0x80; // Example run IP flag
+    // The console prints are kept out of the timed regions, which only measure the use of the IP:
     print_str("Run IP \n");
 
-    while (Iflag); // Whait for an interruption
+    // Example code for reading a file mapped into the memory map and directly
+    // send its contents to a input port of an IP connected to the AXI bus:
+    REGION_BEGIN(REGION_HW);
+    REGION_BEGIN(REGION_LOAD);
+#ifdef APP_NO_DMA
+    // With the processor, four words per STM (see blkcopy.h):
+    blk_to_ip((uint32_t *)(SYS_AXI_BASE + IPIN_OFFSET), RFILE, RFILE_SIZE);
+#else
+    // The same copy with the DMA controller (one byte of the file to one word of the IP, see dma.h):
+    dma_copy(RFILE, (uint32_t *)(SYS_AXI_BASE + IPIN_OFFSET), RFILE_SIZE, DMA_SRC_BYTE | DMA_DST_WORD);
+#endif
+    REGION_END(REGION_LOAD);
+
+    // Mark the beginning of the region of interest (fast-forward mode, see sysctrl.h):
+    SYSCTRL_ROI_BEGIN = 1;
 
-    print_str("***********\nIRQ received\n***********\n ");
+    // Example code of writing in an IP register a starting run flag:
+    REGION_BEGIN(REGION_IRQ_WAIT);
+    enableIRQ(); // They are disabled after every interrupt (e.g. the one of the DMA controller)
+    SYS_MEM32((SYS_AXI_BASE ) ) = 0x80; // Example run IP flag
+
+    // Whait for an interruption (the processor sleeps, see sleep.h), but not forever:
+    if (!timer_wait(&Iflag, APP_IP_TIMEOUT))
+        print_str("Timeout: no interruption of the IP\n");
+    REGION_END(REGION_IRQ_WAIT);
 
     //// Example code for printing the data returned by the IP:
     //print_str("Read from the IP:\n");
@@ -97,9 +145,28 @@ int main()
 
     // Example code for writing a file mapped into the memory map with data
     // directly read from an output port of an IP connected to the AXI bus:
-    for (i = 0; i < WFILE_SIZE; i++)
+    REGION_BEGIN(REGION_DRAIN);
+#ifdef APP_NO_DMA
+    blk_from_ip(WFILE, (uint32_t *)(SYS_AXI_BASE + IPOUT_OFFSET), WFILE_SIZE);
+#else
+    dma_copy((uint32_t *)(SYS_AXI_BASE + IPOUT_OFFSET), WFILE, WFILE_SIZE, DMA_SRC_WORD | DMA_DST_BYTE);
+#endif
+    REGION_END(REGION_DRAIN);
+    REGION_END(REGION_HW);
+
+    print_str("***********\nIRQ received\n***********\n ");
+
+    // The same computation in software, on the same input, to report the speedup of the IP:
+    REGION_BEGIN(REGION_SW);
+    sw_baseline_compute(RFILE, sw_out);
+    REGION_END(REGION_SW);
+    REGION_COMPARE(REGION_IRQ_WAIT, REGION_SW); // Speedup of the computation
+    REGION_COMPARE(REGION_HW, REGION_SW); // Speedup with the transfers
+    for (i = 0, aux = 0; i < IPOUT_SIZE; i++)
+        aux += (sw_out[i] != WFILE[i]);
+    if (aux)
     {
-        WFILE[i] = SYS_MEM32((SYS_AXI_BASE + IPOUT_OFFSET + (4*i) ));
+        print_str("Software baseline mismatches: "); print_int(aux); print_str("\n");
     }
 
     // Example code for printing the data returned by the IP:
@@ -119,8 +186,23 @@ int main()
 
     print_str("IP Done\n");
 
+#ifdef APP_BATCH
+    // The whole dataset with the job rings of the IP, loading the next image while
+    // the IP runs the current one (see batch.h). The first image is the one above:
+    REGION_BEGIN(REGION_BATCH);
+    aux = batch_run(RFILE, WFILE, APP_BATCH_IMAGES, batch_table, APP_IP_TIMEOUT);
+    REGION_END(REGION_BATCH);
+    batch_report(batch_table, APP_BATCH_IMAGES, aux);
+#endif
+
     print_str("***********\nEVERYTHING IS DONE\n***********\n ");
 
+    // Multi-run mode: tell the testbench that this run is finished. If it
+    // has loaded another input, process it from the beginning:
+    SYSCTRL_RUN_DONE = 1;
+    if (SYSCTRL_RUN_PENDING)
+        sysctrl_restart();
+
     halt();
 
     return(1);
@@ -132,6 +214,15 @@ int main()
 void handle_interrupt(void)
 {
     disableIRQ();
+    // End of a DMA transfer (see dma.h):
+    if (dma_irq_handler())
+        return;
+    // Timeouts and periodic ticks (see timer.h):
+    if (timer_irq_handler())
+        return;
+    // Completions of the job rings of the IP (see ipring.h):
+    if (ipring_irq_handler())
+        return;
     SYS_MEM32((SYS_AXI_BASE ) +0) = 0x00; // stop IP
     //print_str("***********\nIRQ received\n***********\n "); // There should not be print calls on interrupt handles
     Iflag  = 0;
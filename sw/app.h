@@ -17,4 +17,34 @@
 #define IPIN_SIZE RFILE_SIZE
 #define IPOUT_SIZE WFILE_SIZE
 
+// Job rings of the IP (see myip and ipring.h):
+// The IP has IP_SLOTS input and output buffers, one after the other from
+// IPIN_OFFSET and IPOUT_OFFSET (slot 0 is the one of the single job mode).
+// The software writes job descriptors on the submission ring and the index
+// of its next free entry on IP_REG_SQ_TAIL (doorbell). The IP runs the jobs
+// back to back, writes every finished descriptor on the completion ring and
+// requests one interrupt for the batch. The indices are free running
+// counters (the entry is the index modulo IP_RING_SIZE).
+#define IP_SLOTS       4
+#define IP_RING_SIZE   8 // Entries of every ring (a power of 2)
+#define IP_SQ_OFFSET   0x08000 // Submission ring (W)
+#define IP_CQ_OFFSET   0x08100 // Completion ring (R)
+
+// Registers (word index from offset 0):
+#define IP_REG_CTRL      0 // W: 0x80 runs the single job mode (slot 0), other values release its interrupt
+#define IP_REG_SQ_TAIL   1 // W: doorbell, index of the next free entry of the submission ring
+#define IP_REG_SQ_HEAD   2 // R: index of the next job to be run
+#define IP_REG_CQ_TAIL   3 // R: index of the next completion to be written
+#define IP_REG_CQ_HEAD   4 // W: index of the next completion to be reaped by the software
+#define IP_REG_COALESCE  5 // W: completions that request the interrupt while jobs are pending (0: only when the ring is drained)
+
+// Job descriptor: input slot, output slot and flags:
+#define IP_JOB(in, out, flags)  ((in) | ((out) << 8) | ((flags) << 16))
+#define IP_JOB_IN(d)     ((d) & 0xFF)
+#define IP_JOB_OUT(d)    (((d) >> 8) & 0xFF)
+#define IP_JOB_FLAGS(d)  (((d) >> 16) & 0xFF)
+#define IP_JOB_IRQ       0x01 // Request the interrupt as soon as this job is finished
+#define IP_JOB_ERROR     0x40 // Set by the IP on the completion ring: wrong slot, the job has not been run
+#define IP_JOB_DONE      0x80 // Set by the IP on the completion ring
+
 
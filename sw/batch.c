@@ -0,0 +1,126 @@
+/***
+ * batch.c
+ * Batched inference driver. See batch.h.
+ */
+
+#include "batch.h"
+#include "app.h"
+#include "ipring.h"
+#include "isrsupport.h"
+#include "dbg_console.h"
+#include "timer.h"
+#ifdef APP_NO_DMA
+#include "blkcopy.h"
+#else
+#include "dma.h"
+#endif
+
+static void load_input(uint32_t slot, const uint8_t *image)
+{
+#ifdef APP_NO_DMA
+    blk_to_ip(IPRING_IN(slot), image, IPIN_SIZE);
+#else
+    dma_copy(image, IPRING_IN(slot), IPIN_SIZE, DMA_SRC_BYTE | DMA_DST_WORD);
+#endif
+}
+
+static void store_output(uint32_t slot, uint8_t *output)
+{
+#ifdef APP_NO_DMA
+    blk_from_ip(output, IPRING_OUT(slot), IPOUT_SIZE);
+#else
+    dma_copy(IPRING_OUT(slot), output, IPOUT_SIZE, DMA_SRC_WORD | DMA_DST_BYTE);
+#endif
+}
+
+uint32_t batch_run(const uint8_t *images, uint8_t *outputs, uint32_t n, batch_result_t *table, uint32_t timeout)
+{
+    uint32_t slot_image[IP_SLOTS]; // Image in flight on every slot
+    uint32_t slot_start[IP_SLOTS]; // Cycle of its load
+    uint32_t free_slots = (1 << IP_SLOTS) - 1; // One bit per slot
+    uint32_t next = 0; // Next image to be loaded
+    uint32_t done = 0; // Images finished
+    uint32_t slot, image, desc, i;
+    uint32_t start = (uint32_t) timer_cycles();
+
+    for (i = 0; i < n; i++)
+    {
+        table[i].status = 0;
+        table[i].slot = 0;
+        table[i].cycles = 0;
+        table[i].checksum = 0;
+    }
+
+    ipring_init(1); // One interrupt per completion, so the slots are freed as soon as possible
+
+    while (done < n)
+    {
+        // Store the outputs of the jobs completed so far and free their slots:
+        if (ipring_reap(&desc, 1))
+        {
+            slot = IP_JOB_OUT(desc);
+            image = slot_image[slot];
+            table[image].status = IP_JOB_FLAGS(desc);
+            if (desc & (IP_JOB_DONE << 16))
+            {
+                store_output(slot, outputs + image * IPOUT_SIZE);
+                for (i = 0; i < IPOUT_SIZE; i++)
+                    table[image].checksum += outputs[image * IPOUT_SIZE + i];
+            }
+            table[image].cycles = (uint32_t) timer_cycles() - slot_start[slot];
+            free_slots |= 1 << slot;
+            done++;
+            continue;
+        }
+
+        // Load the next image on a free slot and start its job at once, so the IP
+        // runs it while the processor loads the next one:
+        if (next < n && free_slots)
+        {
+            for (slot = 0; !(free_slots & (1 << slot)); slot++)
+                ;
+            free_slots &= ~(1 << slot);
+            slot_image[slot] = next;
+            slot_start[slot] = (uint32_t) timer_cycles();
+            table[next].slot = slot;
+            load_input(slot, images + next * IPIN_SIZE);
+            ipring_submit(slot, slot, 0);
+            ipring_doorbell();
+            next++;
+            continue;
+        }
+
+        // Every slot is busy (or every image is started): sleep until a completion:
+        enableIRQ(); // They are disabled after every interrupt (e.g. the one of the DMA controller)
+        if (!timer_wait(&ipring_empty, timeout))
+        {
+            print_str("Batch: timeout, "); print_int(n - done); print_str(" images not completed\n");
+            break;
+        }
+    }
+    enableIRQ();
+
+    return (uint32_t) timer_cycles() - start;
+}
+
+void batch_report(const batch_result_t *table, uint32_t n, uint32_t cycles)
+{
+    uint32_t i, rate;
+    uint32_t clock_hz = TIMER_CLOCK_HZ; // Clock of the simulation (see timer.h)
+
+    print_str("Image Slot Status Cycles Checksum\n");
+    for (i = 0; i < n; i++)
+    {
+        print_int(i); print_str(" ");
+        print_int(table[i].slot); print_str(" ");
+        print_str(table[i].status & IP_JOB_DONE ? "done " : (table[i].status & IP_JOB_ERROR ? "error " : "lost "));
+        print_int(table[i].cycles); print_str(" ");
+        print_hex_uint(table[i].checksum); print_str("\n");
+    }
+
+    // Images per second of simulated time, with two decimals:
+    rate = cycles ? (uint32_t) ((uint64_t) n * clock_hz * 100 / cycles) : 0;
+    print_int(n); print_str(" images in "); print_int(cycles); print_str(" cycles: ");
+    print_int(rate / 100); print_str("."); print_int((rate / 10) % 10); print_int(rate % 10);
+    print_str(" images/s\n");
+}
@@ -0,0 +1,41 @@
+/***
+ * batch.h
+ * Batched inference driver: it runs a dataset of images on the IP
+ * through its job rings (see ipring.h) and keeps the IP busy.
+ *
+ * Every image owns an input and output slot of the IP while it is in
+ * flight. As soon as a slot is free, the next image is loaded on it and
+ * its job is started, so the IP runs a job while the processor loads
+ * the next input or stores the previous output. The interrupt of the
+ * IP only moves the completions to the software queue of ipring.c; the
+ * transfers are done by batch_run().
+ *
+ * Usage:
+ *   batch_result_t table[N];
+ *   uint32_t cycles = batch_run(RFILE, WFILE, N, table, 1000000);
+ *   batch_report(table, N, cycles);
+ * The interrupt handler of the application must call ipring_irq_handler()
+ * (see app.c).
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "mmap.h"
+
+// Result of an image:
+typedef struct {
+    uint32_t status;   // Flags of its completion (IP_JOB_DONE or IP_JOB_ERROR), 0 if it has not been run
+    uint32_t slot;     // Slot of the IP
+    uint32_t cycles;   // From the load of the input to the reaping of the completion
+    uint32_t checksum; // Sum of the output bytes
+} batch_result_t;
+
+// Run the n images of 'images' (IPIN_SIZE bytes each) and store their outputs
+// on 'outputs' (IPOUT_SIZE bytes each) and their results on 'table'. It gives up
+// if no job is completed in 'timeout' cycles. Returns the cycles of the batch:
+uint32_t batch_run(const uint8_t *images, uint8_t *outputs, uint32_t n, batch_result_t *table, uint32_t timeout);
+// Print the table of results and the images per second of simulated time:
+void batch_report(const batch_result_t *table, uint32_t n, uint32_t cycles);
+
+#endif
@@ -0,0 +1,23 @@
+/***
+ * bench.h
+ * Common definitions of the benchmark applications of the simulator
+ * (see tb/bench.sh). They are not meant to do anything useful, only to
+ * stress a given part of the simulation in a repeatable way.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../app.h"
+#include "../mmap.h"
+#include "../isrsupport.h"
+#include "../dbg_console.h"
+
+#define halt()            DBGC_HALT = 1
+
+// Number of iterations of the benchmark loops (it may be given with -DBENCH_ITERATIONS=...):
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS  4096
+#endif
+
+#endif
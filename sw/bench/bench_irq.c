@@ -0,0 +1,42 @@
+/***
+ * bench_irq.c
+ * Benchmark of the simulator: IRQ ping-pong. The processor starts the
+ * IP, waits for its interrupt and acknowledges it, over and over again.
+ */
+
+#include "bench.h"
+
+// Number of ping-pongs (each one runs the IP once):
+#ifndef BENCH_IRQ_ITERATIONS
+#define BENCH_IRQ_ITERATIONS  (BENCH_ITERATIONS / 64)
+#endif
+
+volatile int Iflag;
+
+int main()
+{
+    uint32_t i;
+
+    print_str("Benchmark: IRQ ping-pong\n");
+
+    for (i = 0; i < BENCH_IRQ_ITERATIONS; i++)
+    {
+        Iflag = 1;
+        enableIRQ();
+        SYS_MEM32((SYS_AXI_BASE)) = 0x80; // Run the IP
+        while (Iflag); // Wait for the interruption
+    }
+
+    print_str("IRQs: "); print_uint(i); print_str("\n");
+
+    halt();
+
+    return(1);
+}
+
+void handle_interrupt(void)
+{
+    disableIRQ();
+    SYS_MEM32((SYS_AXI_BASE)) = 0x00; // Stop the IP (it releases the interrupt request)
+    Iflag = 0;
+}
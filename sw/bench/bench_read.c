@@ -0,0 +1,33 @@
+/***
+ * bench_read.c
+ * Benchmark of the simulator: PIO read bandwidth. The processor reads
+ * words from the output port of the IP connected to the AXI bus, so
+ * every iteration is an AXI-lite read transaction.
+ */
+
+#include "bench.h"
+
+int main()
+{
+    uint32_t i;
+    uint32_t sum = 0;
+
+    print_str("Benchmark: PIO read\n");
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        sum += SYS_MEM32((SYS_AXI_BASE + IPOUT_OFFSET + 4*(i % IPOUT_SIZE)));
+    }
+
+    // Print the sum so the reads cannot be optimized away:
+    print_str("Reads: "); print_uint(i); print_str(", sum: "); print_hex_uint(sum); print_str("\n");
+
+    halt();
+
+    return(1);
+}
+
+void handle_interrupt(void)
+{
+    disableIRQ();
+}
@@ -0,0 +1,31 @@
+/***
+ * bench_write.c
+ * Benchmark of the simulator: PIO write bandwidth. The processor writes
+ * words to the input port of the IP connected to the AXI bus, so every
+ * iteration is an AXI-lite write transaction.
+ */
+
+#include "bench.h"
+
+int main()
+{
+    uint32_t i;
+
+    print_str("Benchmark: PIO write\n");
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        SYS_MEM32((SYS_AXI_BASE + IPIN_OFFSET + 4*(i % IPIN_SIZE))) = i;
+    }
+
+    print_str("Writes: "); print_uint(i); print_str("\n");
+
+    halt();
+
+    return(1);
+}
+
+void handle_interrupt(void)
+{
+    disableIRQ();
+}
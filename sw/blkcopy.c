@@ -0,0 +1,178 @@
+/***
+ * blkcopy.c
+ * Block copy and fill routines with LDM/STM. See blkcopy.h
+ *
+ * The blocks use fixed registers (r3-r10), so they are written in
+ * inline assembly. The C versions below them are only used when the
+ * file is not compiled for ARM (e.g. to check it on the host).
+ */
+
+#include "blkcopy.h"
+
+#define ALIGNED(p)  (((uintptr_t)(p) & 3) == 0)
+
+// Copy 'blocks' blocks of 8 words:
+static void copy_blocks(uint32_t *dst, const uint32_t *src, uint32_t blocks)
+{
+#ifdef __arm__
+    asm volatile (
+        "1: ldmia %0!, {r3-r10}\n"
+        "   stmia %1!, {r3-r10}\n"
+        "   subs  %2, %2, #1\n"
+        "   bne   1b\n"
+        : "+r" (src), "+r" (dst), "+r" (blocks)
+        :
+        : "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "cc", "memory");
+#else
+    uint32_t i;
+
+    for (; blocks; blocks--)
+        for (i = 0; i < 8; i++)
+            *dst++ = *src++;
+#endif
+}
+
+void blk_copy(void *dst, const void *src, uint32_t n)
+{
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+
+    // Word blocks only if both buffers can be aligned at once:
+    if (((uintptr_t)d & 3) == ((uintptr_t)s & 3))
+    {
+        while (!ALIGNED(d) && n)
+        {
+            *d++ = *s++;
+            n--;
+        }
+        if (n >= 32)
+        {
+            copy_blocks((uint32_t *)d, (const uint32_t *)s, n / 32);
+            d += n & ~31;
+            s += n & ~31;
+            n &= 31;
+        }
+        for (; n >= 4; n -= 4, d += 4, s += 4)
+            *(uint32_t *)d = *(const uint32_t *)s;
+    }
+    // Tail (or misaligned buffers):
+    while (n--)
+        *d++ = *s++;
+}
+
+void blk_fill(uint32_t *dst, uint32_t value, uint32_t n)
+{
+    uint32_t blocks = n / 8;
+
+    if (blocks)
+    {
+#ifdef __arm__
+        register uint32_t r3 asm ("r3") = value;
+        register uint32_t r4 asm ("r4") = value;
+        register uint32_t r5 asm ("r5") = value;
+        register uint32_t r6 asm ("r6") = value;
+        register uint32_t r7 asm ("r7") = value;
+        register uint32_t r8 asm ("r8") = value;
+        register uint32_t r9 asm ("r9") = value;
+        register uint32_t r10 asm ("r10") = value;
+
+        asm volatile (
+            "1: stmia %0!, {r3-r10}\n"
+            "   subs  %1, %1, #1\n"
+            "   bne   1b\n"
+            : "+r" (dst), "+r" (blocks)
+            : "r" (r3), "r" (r4), "r" (r5), "r" (r6), "r" (r7), "r" (r8), "r" (r9), "r" (r10)
+            : "cc", "memory");
+#else
+        uint32_t i;
+
+        for (; blocks; blocks--)
+            for (i = 0; i < 8; i++)
+                *dst++ = value;
+#endif
+    }
+    for (n &= 7; n; n--)
+        *dst++ = value;
+}
+
+void blk_to_ip(volatile uint32_t *ip, const uint8_t *src, uint32_t n)
+{
+    // Bytes until the source is word aligned:
+    while (!ALIGNED(src) && n)
+    {
+        *ip++ = *src++;
+        n--;
+    }
+    // One word of the source, four words to the IP:
+    for (; n >= 4; n -= 4, src += 4)
+    {
+        uint32_t w = *(const uint32_t *)src;
+#ifdef __arm__
+#ifdef __ARMEB__
+        register uint32_t r3 asm ("r3") = w >> 24;
+        register uint32_t r4 asm ("r4") = (w >> 16) & 0xFF;
+        register uint32_t r5 asm ("r5") = (w >> 8) & 0xFF;
+        register uint32_t r6 asm ("r6") = w & 0xFF;
+#else
+        register uint32_t r3 asm ("r3") = w & 0xFF;
+        register uint32_t r4 asm ("r4") = (w >> 8) & 0xFF;
+        register uint32_t r5 asm ("r5") = (w >> 16) & 0xFF;
+        register uint32_t r6 asm ("r6") = w >> 24;
+#endif
+
+        asm volatile ("stmia %0!, {r3-r6}"
+            : "+r" (ip)
+            : "r" (r3), "r" (r4), "r" (r5), "r" (r6)
+            : "memory");
+#else
+        (void)w;
+        ip[0] = src[0];
+        ip[1] = src[1];
+        ip[2] = src[2];
+        ip[3] = src[3];
+        ip += 4;
+#endif
+    }
+    // Tail:
+    while (n--)
+        *ip++ = *src++;
+}
+
+void blk_from_ip(uint8_t *dst, const volatile uint32_t *ip, uint32_t n)
+{
+    // Bytes until the destination is word aligned:
+    while (!ALIGNED(dst) && n)
+    {
+        *dst++ = (uint8_t)*ip++;
+        n--;
+    }
+    // Four words of the IP, one word to the destination:
+    for (; n >= 4; n -= 4, dst += 4)
+    {
+#ifdef __arm__
+        register uint32_t r3 asm ("r3");
+        register uint32_t r4 asm ("r4");
+        register uint32_t r5 asm ("r5");
+        register uint32_t r6 asm ("r6");
+
+        asm volatile ("ldmia %4!, {r3-r6}"
+            : "=r" (r3), "=r" (r4), "=r" (r5), "=r" (r6), "+r" (ip)
+            :
+            : "memory");
+#ifdef __ARMEB__
+        *(uint32_t *)dst = ((r3 & 0xFF) << 24) | ((r4 & 0xFF) << 16) | ((r5 & 0xFF) << 8) | (r6 & 0xFF);
+#else
+        *(uint32_t *)dst = (r3 & 0xFF) | ((r4 & 0xFF) << 8) | ((r5 & 0xFF) << 16) | ((r6 & 0xFF) << 24);
+#endif
+#else
+        dst[0] = (uint8_t)ip[0];
+        dst[1] = (uint8_t)ip[1];
+        dst[2] = (uint8_t)ip[2];
+        dst[3] = (uint8_t)ip[3];
+        ip += 4;
+#endif
+    }
+    // Tail:
+    while (n--)
+        *dst++ = (uint8_t)*ip++;
+}
@@ -0,0 +1,35 @@
+/***
+ * blkcopy.h
+ * Block copy and fill routines. The data are moved with multi-register
+ * loads and stores (LDM/STM of 4 or 8 words), instead of one access per
+ * element, and the tails that do not fill a whole block are copied word
+ * by word (or byte by byte if the buffers are not aligned alike).
+ *
+ * The IPs on the AXI bus take one element per 32 bit word (e.g. one
+ * byte of a file per word of IPIN_OFFSET, see myip), so blk_to_ip() and
+ * blk_from_ip() unpack and pack the bytes in registers: one word load
+ * of the file feeds a 4 word STM to the IP.
+ *
+ * Usage:
+ *   blk_to_ip((uint32_t *)(SYS_AXI_BASE + IPIN_OFFSET), RFILE, RFILE_SIZE);
+ *   blk_from_ip(WFILE, (uint32_t *)(SYS_AXI_BASE + IPOUT_OFFSET), WFILE_SIZE);
+ */
+
+#ifndef BLKCOPY_H
+#define BLKCOPY_H
+
+#include <inttypes.h>
+
+// Memory to memory copy of 'n' bytes (8 words per block if the buffers are word aligned alike):
+void blk_copy(void *dst, const void *src, uint32_t n);
+
+// Fill 'n' words with 'value' (8 words per block):
+void blk_fill(uint32_t *dst, uint32_t value, uint32_t n);
+
+// Write the 'n' bytes of 'src' on 'n' consecutive words of an IP (zero extended):
+void blk_to_ip(volatile uint32_t *ip, const uint8_t *src, uint32_t n);
+
+// Read 'n' consecutive words of an IP and store their low bytes on 'dst':
+void blk_from_ip(uint8_t *dst, const volatile uint32_t *ip, uint32_t n);
+
+#endif
@@ -0,0 +1,67 @@
+/***
+ * dma.c
+ * Driver of the DMA controller of the simulation platform. See dma.h.
+ */
+
+#include "dma.h"
+#include "isrsupport.h"
+#include "sleep.h"
+
+static volatile int dma_busy = 0; // Chain running, cleared by dma_irq_handler()
+static volatile uint32_t dma_status = 0; // Status of the last chain
+
+void dma_init(void)
+{
+    dma_busy = 0;
+    dma_status = 0;
+    DMA_STATUS = DMA_STATUS_DONE | DMA_STATUS_ERROR; // Release an interrupt request of a previous run
+}
+
+void dma_desc(dma_desc_t *d, const volatile void *src, volatile void *dst, uint32_t count, uint32_t flags)
+{
+    d->next = 0;
+    d->src = (uint32_t)src;
+    d->dst = (uint32_t)dst;
+    d->count = count;
+    d->flags = flags;
+}
+
+void dma_chain(dma_desc_t *d, dma_desc_t *next)
+{
+    d->next = (uint32_t)next;
+}
+
+void dma_start(dma_desc_t *first)
+{
+    dma_busy = 1;
+    enableIRQ();
+    DMA_DESC = (uint32_t)first;
+    DMA_CTRL = DMA_CTRL_START | DMA_CTRL_IRQ_EN;
+}
+
+uint32_t dma_wait(void)
+{
+    sleep_while(&dma_busy); // Wait for the interruption
+    return dma_status;
+}
+
+uint32_t dma_copy(const volatile void *src, volatile void *dst, uint32_t count, uint32_t flags)
+{
+    dma_desc_t d;
+
+    dma_desc(&d, src, dst, count, flags);
+    dma_start(&d);
+    return dma_wait();
+}
+
+int dma_irq_handler(void)
+{
+    uint32_t status = DMA_STATUS;
+
+    if (!(status & (DMA_STATUS_DONE | DMA_STATUS_ERROR)))
+        return 0;
+    DMA_STATUS = status; // Acknowledge (it releases the interrupt request)
+    dma_status = status;
+    dma_busy = 0;
+    return 1;
+}
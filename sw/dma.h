@@ -0,0 +1,80 @@
+/***
+ * dma.h
+ * Registers and driver of the DMA controller of the simulation platform
+ * (see tb/dma.h). It is only present on the SystemC simulation.
+ *
+ * The DMA controller runs a chain of descriptors stored in RAM. Every
+ * descriptor moves 'count' elements from 'src' to 'dst', memory to
+ * memory, memory to AXI or AXI to memory. The size of the source and
+ * destination elements may differ (e.g. bytes of a file to the 32 bit
+ * words of an IP): the elements are zero extended or truncated. When
+ * the chain is finished, the controller raises its interrupt request.
+ *
+ * Usage:
+ *   dma_desc_t d;
+ *   dma_desc(&d, RFILE, (void *)(SYS_AXI_BASE + IPIN_OFFSET), RFILE_SIZE, DMA_SRC_BYTE | DMA_DST_WORD);
+ *   dma_start(&d);
+ *   ... (the processor can do other things)
+ *   dma_wait();
+ * The interrupt handler of the application must call dma_irq_handler()
+ * (see app.c).
+ */
+
+#ifndef DMA_H
+#define DMA_H
+
+#include "mmap.h"
+
+// Register offsets (to the SYS_DMA_BASE address):
+#define DMA_DESC_OFFSET    0x00 // RW: address of the first descriptor of the chain
+#define DMA_CTRL_OFFSET    0x04 // W: DMA_CTRL_START to run the chain, DMA_CTRL_IRQ_EN to interrupt at its end
+#define DMA_STATUS_OFFSET  0x08 // R: DMA_STATUS_* bits; W: 1s clear DONE and ERROR (and the interrupt request)
+#define DMA_COUNT_OFFSET   0x0C // R: descriptors done in the last chain
+
+#define DMA_DESC    SYS_MEM32(SYS_DMA_BASE + DMA_DESC_OFFSET)
+#define DMA_CTRL    SYS_MEM32(SYS_DMA_BASE + DMA_CTRL_OFFSET)
+#define DMA_STATUS  SYS_MEM32(SYS_DMA_BASE + DMA_STATUS_OFFSET)
+#define DMA_COUNT   SYS_MEM32(SYS_DMA_BASE + DMA_COUNT_OFFSET)
+
+#define DMA_CTRL_START      0x1
+#define DMA_CTRL_IRQ_EN     0x2
+
+#define DMA_STATUS_BUSY     0x1
+#define DMA_STATUS_DONE     0x2
+#define DMA_STATUS_ERROR    0x4 // A bus transaction failed or a descriptor is wrong (the chain is stopped)
+
+// Flags of a descriptor: size of the elements (the size code 3 is an error) and addressing:
+#define DMA_SRC_BYTE        0x00
+#define DMA_SRC_HALF        0x01
+#define DMA_SRC_WORD        0x02
+#define DMA_DST_BYTE        0x00
+#define DMA_DST_HALF        0x04
+#define DMA_DST_WORD        0x08
+#define DMA_SRC_FIXED       0x10 // Every element is read from 'src' (e.g. a FIFO port)
+#define DMA_DST_FIXED       0x20 // Every element is written on 'dst'
+
+// Descriptor (in RAM, aligned on 4 bytes):
+typedef struct dma_desc {
+    uint32_t next;  // Address of the next descriptor (0: end of the chain)
+    uint32_t src;   // Address of the first source element
+    uint32_t dst;   // Address of the first destination element
+    uint32_t count; // Number of elements
+    uint32_t flags; // DMA_SRC_*, DMA_DST_*
+} dma_desc_t;
+
+// Initialize the state of the driver (at the beginning of every run, the .data section is not reloaded):
+void dma_init(void);
+// Fill the descriptor 'd' (at the end of a chain):
+void dma_desc(dma_desc_t *d, const volatile void *src, volatile void *dst, uint32_t count, uint32_t flags);
+// Append 'next' to the descriptor 'd':
+void dma_chain(dma_desc_t *d, dma_desc_t *next);
+// Run the chain from 'first' (it enables the interrupts of the processor):
+void dma_start(dma_desc_t *first);
+// Wait for the end of the chain started by dma_start(). It returns the DMA_STATUS_* bits of the chain:
+uint32_t dma_wait(void);
+// Single transfer: dma_desc, dma_start and dma_wait:
+uint32_t dma_copy(const volatile void *src, volatile void *dst, uint32_t count, uint32_t flags);
+// To be called by the interrupt handler: returns 1 if the interrupt came from the DMA controller (and acknowledges it):
+int dma_irq_handler(void);
+
+#endif
@@ -0,0 +1,102 @@
+/***
+ * ipring.c
+ * Driver of the job rings of the IP. See ipring.h.
+ */
+
+#include "ipring.h"
+#include "isrsupport.h"
+#include "sleep.h"
+
+#define IP_REG(n)  SYS_MEM32(SYS_AXI_BASE + 4 * (n))
+#define IP_SQ(i)   SYS_MEM32(SYS_AXI_BASE + IP_SQ_OFFSET + 4 * ((i) % IP_RING_SIZE))
+#define IP_CQ(i)   SYS_MEM32(SYS_AXI_BASE + IP_CQ_OFFSET + 4 * ((i) % IP_RING_SIZE))
+
+static uint32_t sq_tail = 0; // Next entry of the submission ring
+static uint32_t doorbell = 0; // Last value written on IP_REG_SQ_TAIL
+static uint32_t cq_head = 0; // Next completion of the IP to be collected
+
+// Completions collected and not reaped yet. There are never more than
+// IP_RING_SIZE jobs between ipring_submit() and ipring_reap():
+static uint32_t done_ring[IP_RING_SIZE];
+static volatile uint32_t done_head = 0;
+static volatile uint32_t done_tail = 0;
+
+volatile int ipring_empty = 1;
+
+void ipring_init(unsigned coalesce)
+{
+    sq_tail = doorbell = IP_REG(IP_REG_SQ_TAIL);
+    cq_head = IP_REG(IP_REG_CQ_HEAD);
+    done_head = done_tail = 0;
+    ipring_empty = 1;
+    IP_REG(IP_REG_COALESCE) = coalesce;
+}
+
+int ipring_submit(unsigned in, unsigned out, unsigned flags)
+{
+    if (sq_tail - done_head >= IP_RING_SIZE)
+        return 0;
+    IP_SQ(sq_tail) = IP_JOB(in, out, flags);
+    sq_tail++;
+    return 1;
+}
+
+void ipring_doorbell(void)
+{
+    if (doorbell != sq_tail)
+    {
+        doorbell = sq_tail;
+        IP_REG(IP_REG_SQ_TAIL) = doorbell;
+    }
+}
+
+unsigned ipring_collect(void)
+{
+    uint32_t tail = IP_REG(IP_REG_CQ_TAIL);
+    unsigned n = 0;
+
+    while (cq_head != tail)
+    {
+        done_ring[done_tail % IP_RING_SIZE] = IP_CQ(cq_head);
+        done_tail++;
+        cq_head++;
+        n++;
+    }
+    if (n)
+    {
+        IP_REG(IP_REG_CQ_HEAD) = cq_head; // It releases the interrupt request
+        ipring_empty = 0;
+    }
+    return n;
+}
+
+unsigned ipring_reap(uint32_t *done, unsigned max)
+{
+    unsigned old = disableIRQ();
+    unsigned n = 0;
+
+    ipring_collect(); // Without interrupts too
+    while (n < max && done_head != done_tail)
+    {
+        done[n++] = done_ring[done_head % IP_RING_SIZE];
+        done_head++;
+    }
+    ipring_empty = (done_head == done_tail);
+    restoreIRQ(old);
+    return n;
+}
+
+unsigned ipring_pending(void)
+{
+    return sq_tail - done_head;
+}
+
+void ipring_wait(void)
+{
+    sleep_while(&ipring_empty);
+}
+
+int ipring_irq_handler(void)
+{
+    return ipring_collect() != 0;
+}
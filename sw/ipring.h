@@ -0,0 +1,56 @@
+/***
+ * ipring.h
+ * Driver of the job rings of the IP (see IP_SQ_OFFSET in app.h).
+ *
+ * The IP has IP_SLOTS input and output buffers. A job runs the
+ * "computations" from an input slot to an output slot. The software
+ * queues jobs with ipring_submit() and starts them with
+ * ipring_doorbell(): the IP runs them back to back and requests one
+ * interrupt for the whole batch (or every IP_REG_COALESCE completions,
+ * or after a job with IP_JOB_IRQ). The interrupt handler moves the
+ * completions to a software queue (ipring_irq_handler()), from where
+ * the application takes them with ipring_reap().
+ *
+ * Usage:
+ *   ipring_init(0);
+ *   ... (write the inputs on IPRING_IN(0) and IPRING_IN(1))
+ *   ipring_submit(0, 0, 0);
+ *   ipring_submit(1, 1, 0);
+ *   ipring_doorbell();
+ *   ipring_wait();
+ *   n = ipring_reap(done, 2); // Completed descriptors (IP_JOB_IN/OUT/FLAGS)
+ * The interrupt handler of the application must call ipring_irq_handler()
+ * (see app.c).
+ */
+
+#ifndef IPRING_H
+#define IPRING_H
+
+#include "mmap.h"
+#include "app.h"
+
+// Buffers of a slot, one element per word (like IPIN_OFFSET and IPOUT_OFFSET):
+#define IPRING_IN(slot)   ((uint32_t *)(SYS_AXI_BASE + IPIN_OFFSET + (slot) * IPIN_SIZE * 4))
+#define IPRING_OUT(slot)  ((uint32_t *)(SYS_AXI_BASE + IPOUT_OFFSET + (slot) * IPOUT_SIZE * 4))
+
+// Start from the current indices of the IP (after its reset). coalesce: see IP_REG_COALESCE:
+void ipring_init(unsigned coalesce);
+// Queue a job from the input slot 'in' to the output slot 'out' (IP_JOB_* flags).
+// Returns 0 if IP_RING_SIZE jobs are already submitted and not reaped:
+int ipring_submit(unsigned in, unsigned out, unsigned flags);
+// Start the jobs submitted since the last call:
+void ipring_doorbell(void);
+// Move the completions of the IP to the software queue (also called by ipring_irq_handler()). Returns their number:
+unsigned ipring_collect(void);
+// Take up to 'max' completed descriptors from the software queue. Returns their number:
+unsigned ipring_reap(uint32_t *done, unsigned max);
+// Jobs submitted and not reaped yet:
+unsigned ipring_pending(void);
+// 1 while there is no completion to be reaped (e.g. for timer_wait(&ipring_empty, cycles)):
+extern volatile int ipring_empty;
+// Sleep until there is a completion to be reaped. The interrupts are disabled on return (see sleep.h):
+void ipring_wait(void);
+// To be called by the interrupt handler: returns 1 if the interrupt came from the job rings (the completions are collected):
+int ipring_irq_handler(void);
+
+#endif
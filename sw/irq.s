@@ -11,8 +11,14 @@ irq_handler:
 	stmfd sp!,{r0-r3,fp,r12,lr}
 	/* Execute interrupt handler function*/
 	BL  handle_interrupt
-	/* Load registers, frame pointer and Link register (to Program counter) from stack */
-	ldmfd sp!,{r0-r3,fp,r12,pc}
+	/* The interrupts stay disabled after the handler (the application
+	 * enables them again before waiting for the next one, see enableIRQ) */
+	mrs r0, spsr
+	orr r0, r0, #0x80
+	msr spsr_c, r0
+	/* Load registers, frame pointer and Link register (to Program counter) from stack,
+	 * and return to the interrupted mode (^: the CPSR is restored from the SPSR) */
+	ldmfd sp!,{r0-r3,fp,r12,pc}^
 
 	.endfunc
 
@@ -51,6 +51,22 @@
 #define  SYS_RWNUM_RAM_BASE   0xB2000000
 #define  SYS_RWNUM_RAM_SIZE   10
 
+// System control block of the SystemC simulation (multi-run control). See sysctrl.h
+#define  SYS_SYSCTRL_BASE   0xB3000000
+#define  SYS_SYSCTRL_SIZE   0x000000FF
+
+// Region markers of the SystemC simulation (timing of code regions). See region.h
+#define  SYS_REGION_BASE   0xB4000000
+#define  SYS_REGION_SIZE   0x000000FF
+
+// DMA controller of the SystemC simulation (scatter-gather transfers). See dma.h
+#define  SYS_DMA_BASE   0xB5000000
+#define  SYS_DMA_SIZE   0x000000FF
+
+// Cycle counter and timer of the SystemC simulation. See timer.h
+#define  SYS_TIMER_BASE   0xB6000000
+#define  SYS_TIMER_SIZE   0x000000FF
+
 // ...
 
 /* AXI Bus (to connect IPs) */
@@ -0,0 +1,32 @@
+/***
+ * region.h
+ * Region markers: timing of code regions of the application on the
+ * SystemC simulation (see tb/region_marker.h). Surround a region with
+ * REGION_BEGIN(n) and REGION_END(n), where n is a number between 0 and
+ * REGION_COUNT-1. Every marker is a single bus write, so it hardly
+ * changes the timing of the application. At the end of the simulation,
+ * sctop prints the min/avg/max cycles of every region.
+ * Regions with different numbers can be nested or overlapped.
+ *
+ * REGION_COMPARE(a, b) asks for the ratio of the average cycles of the
+ * regions b and a in the report, e.g. the speedup of the IP (region a)
+ * over the same computation in software (region b).
+ */
+
+#ifndef REGION_H
+#define REGION_H
+
+#include "mmap.h"
+
+#define REGION_COUNT  16 // Number of regions
+
+// Register offsets (to the SYS_REGION_BASE address):
+#define REGION_BEGIN_OFFSET  0x00 // W: beginning of the region written
+#define REGION_END_OFFSET    0x04 // W: end of the region written
+#define REGION_COMPARE_OFFSET 0x08 // W: (a << 16) | b, report the cycles of region b over region a
+
+#define REGION_BEGIN(n)  (SYS_MEM32(SYS_REGION_BASE + REGION_BEGIN_OFFSET) = (n))
+#define REGION_END(n)    (SYS_MEM32(SYS_REGION_BASE + REGION_END_OFFSET) = (n))
+#define REGION_COMPARE(a, b)  (SYS_MEM32(SYS_REGION_BASE + REGION_COMPARE_OFFSET) = ((a) << 16) | (b))
+
+#endif
@@ -0,0 +1,30 @@
+/***
+ * sleep.c
+ * Sleep of the processor until an interrupt. See sleep.h
+ */
+
+#include "sleep.h"
+#include "isrsupport.h"
+#ifndef SLEEP_CP15_WFI
+#include "sysctrl.h"
+#endif
+
+void cpu_sleep(void)
+{
+#ifdef SLEEP_CP15_WFI
+    asm volatile ("mcr p15, 0, %0, c7, c0, 4" : : "r" (0) : "memory");
+#else
+    SYSCTRL_SLEEP = 1;
+#endif
+}
+
+void sleep_while(volatile int *flag)
+{
+    disableIRQ();
+    while (*flag)
+    {
+        cpu_sleep();
+        enableIRQ(); // The pending interrupt is taken here, then they are disabled again by irq.s
+        disableIRQ();
+    }
+}
@@ -0,0 +1,29 @@
+/***
+ * sleep.h
+ * Sleep of the processor until an interrupt, instead of busy waiting.
+ *
+ * On the SystemC simulation the processor sleeps by writing
+ * SYSCTRL_SLEEP (see sysctrl.h): the testbench stops stepping the ISS
+ * until an interrupt is requested, so the wait costs no host time and
+ * the interrupt latency is the same as with a busy loop. On the board,
+ * build with -DSLEEP_CP15_WFI to use the wait-for-interrupt operation
+ * of the ARM v5/v6 cores (CP15 c7, c0, 4) instead.
+ *
+ * Usage (the flag is cleared by the interrupt handler):
+ *   sleep_while(&flag);
+ */
+
+#ifndef SLEEP_H
+#define SLEEP_H
+
+// Sleep until an interrupt is requested. Call it with the interrupts
+// disabled, after testing the wake up condition, so that an interrupt
+// between the test and the sleep is not lost (it returns at once):
+void cpu_sleep(void);
+
+// Sleep until *flag is 0. The interrupts are disabled on return, as
+// after every interrupt (see irq.s): enable them again before the next
+// wait, once the request of the interrupting device is released:
+void sleep_while(volatile int *flag);
+
+#endif
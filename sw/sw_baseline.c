@@ -0,0 +1,52 @@
+/***
+ * sw_baseline.c
+ * Software implementation of the computations of the IP. See
+ * sw_baseline.h
+ */
+
+#include "sw_baseline.h"
+
+// Executed from RAM, and optimized whatever the flags of the Makefile (-O0):
+#define SW_BASELINE_FAST  __attribute__((section(".text.fastcode"), optimize("O2")))
+
+// Reverse the bytes of a word. At -O0 a plain inline function is not inlined,
+// not even in an optimized caller, so it is forced (with the same attributes):
+static inline __attribute__((always_inline)) SW_BASELINE_FAST uint32_t bswap32(uint32_t x)
+{
+#if defined(__ARM_ARCH_6__) || defined(__ARM_ARCH_6J__) || defined(__ARM_ARCH_6K__) || \
+    defined(__ARM_ARCH_6Z__) || defined(__ARM_ARCH_6ZK__)
+    asm ("rev %0, %1" : "=r" (x) : "r" (x));
+    return x;
+#else
+    // Four instructions on ARM v5 (there is no REV):
+    uint32_t t = x ^ ((x >> 16) | (x << 16));
+    t &= ~0x00FF0000;
+    x = (x >> 8) | (x << 24);
+    return x ^ (t >> 8);
+#endif
+}
+
+SW_BASELINE_FAST void sw_baseline_compute(const uint8_t *in, uint8_t *out)
+{
+#if IPIN_SIZE % 16 == 0
+    // 16 bytes per iteration: the last word of the input, byte reversed, is the first one of the output
+    const uint32_t *src = (const uint32_t *)(in + IPIN_SIZE);
+    uint32_t *dst = (uint32_t *)out;
+    unsigned n;
+
+    for (n = IPIN_SIZE / 16; n; n--)
+    {
+        src -= 4;
+        dst[0] = bswap32(src[3]);
+        dst[1] = bswap32(src[2]);
+        dst[2] = bswap32(src[1]);
+        dst[3] = bswap32(src[0]);
+        dst += 4;
+    }
+#else
+    unsigned i;
+
+    for (i = 0; i < IPIN_SIZE; i++)
+        out[i] = in[IPIN_SIZE - i - 1];
+#endif
+}
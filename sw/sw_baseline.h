@@ -0,0 +1,25 @@
+/***
+ * sw_baseline.h
+ * Software implementation of the computations of the IP (the same as
+ * myip::write_cthread and tb/golden_model.cpp), to measure the speedup
+ * of the IP on the same inputs. It is optimized for the ARM v5/v6 cores
+ * of the ISS: it works on 32 bit words (REV on v6), its loop is
+ * unrolled and it is executed from RAM (.fastcode, see app.ld).
+ *
+ * Usage (see app.c):
+ *   REGION_BEGIN(n);
+ *   sw_baseline_compute(input, output);
+ *   REGION_END(n);
+ * The buffers must be 32 bit aligned.
+ */
+
+#ifndef SW_BASELINE_H
+#define SW_BASELINE_H
+
+#include <inttypes.h>
+#include "app.h"
+
+// out[i] = in[IPIN_SIZE-1-i], for i from 0 to IPIN_SIZE-1:
+void sw_baseline_compute(const uint8_t *in, uint8_t *out);
+
+#endif
@@ -0,0 +1,44 @@
+/***
+ * sysctrl.h
+ * Registers of the system control block of the simulation platform
+ * (see tb/sysctrl.h). It is only present on the SystemC simulation.
+ *
+ * Multi-run mode: when sctop is given a list of input files, the
+ * application tells the testbench that the current run is finished by
+ * writing SYSCTRL_RUN_DONE. The testbench then stores the outputs of
+ * the run, loads the next input and resets the AXI IPs. If another run
+ * is pending, the application restarts from the reset vector.
+ *
+ * Fast-forward mode: writing SYSCTRL_ROI_BEGIN marks the beginning of
+ * the region of interest, from where the IP is simulated at cycle
+ * level (see tb/fast_forward.h). It has no effect otherwise.
+ *
+ * Sleep: writing SYSCTRL_SLEEP stops the processor until an interrupt
+ * is requested, like the wait-for-interrupt of the ARM cores (see
+ * sleep.h). The testbench does not step the ISS meanwhile.
+ */
+
+#ifndef SYSCTRL_H
+#define SYSCTRL_H
+
+#include "mmap.h"
+
+// Register offsets (to the SYS_SYSCTRL_BASE address):
+#define SYSCTRL_RUN_DONE_OFFSET     0x00 // W: the current run is finished
+#define SYSCTRL_RUN_PENDING_OFFSET  0x04 // R: 1 if another run has been loaded, 0 otherwise
+#define SYSCTRL_RUN_INDEX_OFFSET    0x08 // R: index of the current run (starting at 0)
+#define SYSCTRL_RUN_COUNT_OFFSET    0x0C // R: number of runs of the simulation
+#define SYSCTRL_ROI_BEGIN_OFFSET    0x10 // W: beginning of the region of interest (trigger of the fast-forward mode)
+#define SYSCTRL_SLEEP_OFFSET        0x14 // W: wait for an interrupt request
+
+#define SYSCTRL_RUN_DONE     SYS_MEM32(SYS_SYSCTRL_BASE + SYSCTRL_RUN_DONE_OFFSET)
+#define SYSCTRL_RUN_PENDING  SYS_MEM32(SYS_SYSCTRL_BASE + SYSCTRL_RUN_PENDING_OFFSET)
+#define SYSCTRL_RUN_INDEX    SYS_MEM32(SYS_SYSCTRL_BASE + SYSCTRL_RUN_INDEX_OFFSET)
+#define SYSCTRL_RUN_COUNT    SYS_MEM32(SYS_SYSCTRL_BASE + SYSCTRL_RUN_COUNT_OFFSET)
+#define SYSCTRL_ROI_BEGIN    SYS_MEM32(SYS_SYSCTRL_BASE + SYSCTRL_ROI_BEGIN_OFFSET)
+#define SYSCTRL_SLEEP        SYS_MEM32(SYS_SYSCTRL_BASE + SYSCTRL_SLEEP_OFFSET)
+
+// Restart the application from the reset vector (see startup.s):
+#define sysctrl_restart()    asm volatile ("b _start")
+
+#endif
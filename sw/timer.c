@@ -0,0 +1,67 @@
+/***
+ * timer.c
+ * Driver of the cycle counter and timer of the simulation platform. See
+ * timer.h.
+ */
+
+#include "timer.h"
+#include "isrsupport.h"
+#include "sleep.h"
+
+static volatile uint32_t ticks = 0; // Expirations since timer_start(), counted by timer_irq_handler()
+
+uint64_t timer_cycles(void)
+{
+    uint32_t lo = TIMER_COUNT_LO; // Latches the high word
+
+    return ((uint64_t)TIMER_COUNT_HI << 32) | lo;
+}
+
+void timer_init(void)
+{
+    timer_stop();
+    ticks = 0;
+}
+
+void timer_start(uint32_t cycles, uint32_t flags)
+{
+    ticks = 0;
+    TIMER_STATUS = TIMER_STATUS_EXPIRED;
+    TIMER_LOAD = cycles;
+    enableIRQ();
+    TIMER_CTRL = TIMER_CTRL_ENABLE | TIMER_CTRL_IRQ_EN | (flags & TIMER_CTRL_PERIODIC);
+}
+
+void timer_stop(void)
+{
+    TIMER_CTRL = 0;
+    TIMER_STATUS = TIMER_STATUS_EXPIRED;
+}
+
+uint32_t timer_ticks(void)
+{
+    return ticks;
+}
+
+int timer_wait(volatile int *flag, uint32_t cycles)
+{
+    timer_start(cycles, 0);
+    disableIRQ();
+    while (*flag && !ticks)
+    {
+        cpu_sleep();
+        enableIRQ(); // The pending interrupt is taken here, then they are disabled again by irq.s
+        disableIRQ();
+    }
+    timer_stop();
+    return *flag == 0;
+}
+
+int timer_irq_handler(void)
+{
+    if (!(TIMER_STATUS & TIMER_STATUS_EXPIRED))
+        return 0;
+    TIMER_STATUS = TIMER_STATUS_EXPIRED; // Acknowledge (it releases the interrupt request)
+    ticks++;
+    return 1;
+}
@@ -0,0 +1,74 @@
+/***
+ * timer.h
+ * Registers and driver of the cycle counter and timer of the simulation
+ * platform (see tb/timer.h). It is only present on the SystemC
+ * simulation.
+ *
+ * The cycle counter is a free running 64 bit count of the clock cycles
+ * since the beginning of the simulation. Reading TIMER_COUNT_LO latches
+ * the high word in TIMER_COUNT_HI, so read the low word first (see
+ * timer_cycles()).
+ *
+ * The timer counts down TIMER_LOAD cycles, then sets TIMER_STATUS_EXPIRED
+ * and, if TIMER_CTRL_IRQ_EN is set, raises its interrupt request until
+ * the software clears the status. A one-shot timer stops; a periodic
+ * one (TIMER_CTRL_PERIODIC) starts again with the same period.
+ *
+ * Usage:
+ *   uint64_t t0 = timer_cycles();
+ *   ... (phase to be measured)
+ *   print_int((uint32_t)(timer_cycles() - t0));
+ *
+ *   if (!timer_wait(&flag, 100000)) ... (timeout: the flag was not cleared)
+ *
+ *   timer_start(1000, TIMER_CTRL_PERIODIC); // One tick every 1000 cycles
+ *   ... (e.g. send an input every time timer_ticks() changes)
+ * The interrupt handler of the application must call timer_irq_handler()
+ * (see app.c).
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "mmap.h"
+
+// Register offsets (to the SYS_TIMER_BASE address):
+#define TIMER_COUNT_LO_OFFSET  0x00 // R: low word of the cycle counter (latches the high word)
+#define TIMER_COUNT_HI_OFFSET  0x04 // R: high word of the cycle counter, latched by the last read of COUNT_LO
+#define TIMER_LOAD_OFFSET      0x08 // RW: period of the timer, in cycles
+#define TIMER_VALUE_OFFSET     0x0C // R: cycles until the timer expires (0 if it is stopped)
+#define TIMER_CTRL_OFFSET      0x10 // RW: TIMER_CTRL_* bits; writing TIMER_CTRL_ENABLE (re)starts the timer
+#define TIMER_STATUS_OFFSET    0x14 // R: TIMER_STATUS_* bits; W: 1s clear them (and the interrupt request)
+#define TIMER_CLOCK_HZ_OFFSET  0x18 // R: frequency of the clock of the counter, in Hz
+
+#define TIMER_COUNT_LO  SYS_MEM32(SYS_TIMER_BASE + TIMER_COUNT_LO_OFFSET)
+#define TIMER_COUNT_HI  SYS_MEM32(SYS_TIMER_BASE + TIMER_COUNT_HI_OFFSET)
+#define TIMER_LOAD      SYS_MEM32(SYS_TIMER_BASE + TIMER_LOAD_OFFSET)
+#define TIMER_VALUE     SYS_MEM32(SYS_TIMER_BASE + TIMER_VALUE_OFFSET)
+#define TIMER_CTRL      SYS_MEM32(SYS_TIMER_BASE + TIMER_CTRL_OFFSET)
+#define TIMER_STATUS    SYS_MEM32(SYS_TIMER_BASE + TIMER_STATUS_OFFSET)
+#define TIMER_CLOCK_HZ  SYS_MEM32(SYS_TIMER_BASE + TIMER_CLOCK_HZ_OFFSET)
+
+#define TIMER_CTRL_ENABLE     0x1
+#define TIMER_CTRL_PERIODIC   0x2
+#define TIMER_CTRL_IRQ_EN     0x4
+
+#define TIMER_STATUS_EXPIRED  0x1
+
+// Cycles since the beginning of the simulation:
+uint64_t timer_cycles(void);
+// Stop the timer and initialize the state of the driver (at the beginning of every run, the .data section is not reloaded):
+void timer_init(void);
+// Start the timer with a period of 'cycles' and its interrupt. flags: 0 (one-shot) or TIMER_CTRL_PERIODIC:
+void timer_start(uint32_t cycles, uint32_t flags);
+// Stop the timer (and release its interrupt request):
+void timer_stop(void);
+// Number of times the timer has expired since the last timer_start():
+uint32_t timer_ticks(void);
+// Sleep until *flag is 0 or 'cycles' have elapsed (one-shot timer). Returns 0 on timeout, 1 otherwise.
+// The interrupts are disabled on return (see sleep.h):
+int timer_wait(volatile int *flag, uint32_t cycles);
+// To be called by the interrupt handler: returns 1 if the interrupt came from the timer (and acknowledges it):
+int timer_irq_handler(void);
+
+#endif
@@ -177,6 +177,10 @@ void AXISlave::w_cthread(void)
  */
 void AXISlave::write_method(void)
 {
+#ifndef __SYNTHESIS__
+    SC_PROFILE_METHOD();
+    SIM_STATS_ACTIVATION();
+#endif
     s_ip_wvalid.write( s_ip_awvalid_aux.read() & s_ip_wvalid_aux.read() );
 }
 
@@ -129,6 +129,10 @@ SC_MODULE (AXISlave)
     void r_cthread(void);  // Read data channel clock thread
     void write_method(void); // Simplified write channel WVALID generation in a combinational method
 
+#ifndef __SYNTHESIS__
+    SIM_STATS_WAIT_WRAPPERS // Activations and profiler of the SystemC processes (simulation only, see tb/sim_stats.h)
+#endif
+
 
     /* Constructor: */
     SC_CTOR(AXISlave) : myip_1("myip_1")
@@ -52,6 +52,9 @@
  * 
  * It also runs the "computations" when a certain patern is written in
  * a certain register(s), and signals an interrupt request when finish.
+ * While there is no data to write, it runs the jobs of the submission
+ * ring, so the registers, the rings and the buffers are only written
+ * by this thread.
  * 
  * It is intended to be use as an example and templete for writing data
  * comming from the AXI bus into the correct memory or register.
@@ -64,6 +67,14 @@ void myip::write_cthread()
     // Initialization of output ports:
     s_ip_wready.write(false);
     interrupt_request.write(false);
+    ring_busy.write(false);
+
+    // Empty job rings:
+    registers[IP_REG_SQ_TAIL] = 0;
+    registers[IP_REG_SQ_HEAD] = 0;
+    registers[IP_REG_CQ_TAIL] = 0;
+    registers[IP_REG_CQ_HEAD] = 0;
+    registers[IP_REG_COALESCE] = 0;
 
     // Internal variables:
     //int int_data = 0; // For an unimplemented example
@@ -71,6 +82,10 @@ void myip::write_cthread()
     unsigned axi_waddr = 0;
     unsigned waddr = 0;
     sc_uint<AXI_DATA_WIDTH> axi_data = 0;
+    bool single_irq = false; // Interrupt request of the single job mode
+    unsigned job = 0; // Descriptor of the job of the submission ring being run
+    unsigned in = 0;
+    unsigned out = 0;
 
     // WARNING: variable registers is not initialized. If it is intended to be synthesized as registers, it is better to initialize it. Arrays intended to be synthesized as memory blocks (i.e. BRAM or LutRAM on Xilinx FPGAs) is better to do NOT initialize them.
 
@@ -88,8 +103,45 @@ void myip::write_cthread()
         // It is a slow IP, so the default state should be LOW. Another option is to use the pragma protocol to force a fast reply.
         s_ip_wready.write(false);
 
-        // Wait for WVALID:
-        while ( !s_ip_wvalid.read() ) wait();
+        // Wait for WVALID. Meanwhile, run the jobs of the submission ring back to back,
+        // from registers[IP_REG_SQ_HEAD] to registers[IP_REG_SQ_TAIL] (the doorbell):
+        while ( !s_ip_wvalid.read() )
+        {
+            if ( registers[IP_REG_SQ_HEAD] != registers[IP_REG_SQ_TAIL] )
+            {
+                ring_busy.write(true);
+                job = sq[registers[IP_REG_SQ_HEAD] % IP_RING_SIZE];
+                in = IP_JOB_IN(job);
+                out = IP_JOB_OUT(job);
+                if ( in < IP_SLOTS && out < IP_SLOTS )
+                {
+                    // Same "computations" as the single job mode, from and to the slots of the job:
+                    for(int i=0; i<IPIN_SIZE; i++)
+                    {
+                        outbuff[out*IPOUT_SIZE + i] = inbuff[in*IPIN_SIZE + IPIN_SIZE - i - 1];
+                    }
+                    job |= IP_JOB_DONE << 16;
+                }
+                else
+                {
+                    job |= IP_JOB_ERROR << 16;
+                }
+                wait(); // Update computed values before the completion
+
+                // Post the completion:
+                cq[registers[IP_REG_CQ_TAIL] % IP_RING_SIZE] = job;
+                registers[IP_REG_CQ_TAIL]++;
+                registers[IP_REG_SQ_HEAD]++;
+            }
+            else
+            {
+                ring_busy.write(false);
+            }
+
+            // The request of the rings is coalesced (see ring_irq_level):
+            interrupt_request.write(single_irq || ring_irq_level());
+            wait();
+        }
 
         // While dealing with the data this IP is not able to receive new data, so WREADY is deasserted (for fast IPs):
         //s_ip_wready.write(false); // already default value
@@ -123,7 +175,13 @@ void myip::write_cthread()
             case 0 ... 16*4:
             {
                 waddr = axi_waddr >> 2; // Addapt the 8 bit word address to 32 bit word address
-                registers[waddr] = axi_data; // + 21; // +21 is a debbuging/checking trick, you can safely remove it
+                // The indices updated by the IP are read only:
+                if ( waddr != IP_REG_SQ_HEAD && waddr != IP_REG_CQ_TAIL )
+                    registers[waddr] = axi_data; // + 21; // +21 is a debbuging/checking trick, you can safely remove it
+
+                // Only register 0 controls the single job mode (the doorbell is served while waiting for WVALID):
+                if ( waddr != IP_REG_CTRL )
+                    break;
 
                 // Writing on the register 0 triggers the "computations":
                 if ( (axi_data & 0x80)  == 0x80 )
@@ -139,12 +197,14 @@ void myip::write_cthread()
                     wait(); // Update computed values and forces interrupt_request assertion to become after
 
                     // Generate an interrupt request:
+                    single_irq = true;
                     interrupt_request.write(true);
                 }
                 else
                 {
                     // Disable the interrupt request when whatever other value is written in register 0
-                    interrupt_request.write(false);
+                    single_irq = false;
+                    interrupt_request.write(ring_irq_level());
                 }
 
                 break;
@@ -163,7 +223,14 @@ void myip::write_cthread()
                 //waddr = (axi_waddr - IPIN_OFFSET) >> 2;
                 char_data = axi_data.range(7,0); // Give proper format to the data
                 //wait(); // It may be necessary to break a critical path, but it will also complicates the FSM which may cause side problems
-                inbuff[waddr] = char_data; // Store read data on the input buffer
+                if ( waddr < IPIN_SIZE*IP_SLOTS )
+                    inbuff[waddr] = char_data; // Store read data on the input buffer
+                break;
+            }
+            // Submission ring:
+            case  IP_SQ_OFFSET ... IP_SQ_OFFSET+IP_RING_SIZE*4-1 :
+            {
+                sq[(axi_waddr - IP_SQ_OFFSET) >> 2] = axi_data;
                 break;
             }
             // Another example for reading data. Here integer data are read with a mechanism to prevent read the same data twice:
@@ -246,8 +313,14 @@ void myip::read_cthread()
                 axi_dataout = registers[raddr]; // Put data of the register in a local variable. You may need to format properly the data.
                 break;
             }
+            // Completion ring:
+            case  IP_CQ_OFFSET ... IP_CQ_OFFSET+IP_RING_SIZE*4-1 :
+            {
+                axi_dataout = cq[(axi_raddr - IP_CQ_OFFSET) >> 2];
+                break;
+            }
             // Output port:
-            case  IPOUT_OFFSET ... (IPOUT_OFFSET+IPOUT_SIZE*4)-1 :
+            case  IPOUT_OFFSET ... (IPOUT_OFFSET+IPOUT_SIZE*IP_SLOTS*4)-1 :
             {
                 // Addapt the address:
 #if IPIN_OFFSET >= IPOUT_SIZE*4
@@ -280,3 +353,29 @@ void myip::read_cthread()
     }
 }
 
+
+/***
+ * Coalesced interrupt request of the completion ring: there are
+ * completions not reaped by the software (registers[IP_REG_CQ_HEAD])
+ * and the submission ring is drained, or IP_REG_COALESCE completions
+ * are pending, or one of them asked for it (IP_JOB_IRQ).
+ */
+bool myip::ring_irq_level()
+{
+    unsigned pending = registers[IP_REG_CQ_TAIL] - registers[IP_REG_CQ_HEAD];
+    bool irq = false;
+
+    if ( pending == 0 )
+        return false;
+    if ( registers[IP_REG_SQ_HEAD] == registers[IP_REG_SQ_TAIL] )
+        return true;
+    if ( registers[IP_REG_COALESCE] && pending >= registers[IP_REG_COALESCE] )
+        return true;
+    for (unsigned i = 0; i < IP_RING_SIZE; i++)
+    {
+        if ( i < pending && (IP_JOB_FLAGS(cq[(registers[IP_REG_CQ_HEAD] + i) % IP_RING_SIZE]) & IP_JOB_IRQ) )
+            irq = true;
+    }
+    return irq;
+}
+
@@ -14,6 +14,12 @@
  * It also generates an interrupt request when the "computations" are
  * finished.
  * 
+ * The "computations" are started either by writing 0x80 in register 0
+ * (single job mode, slot 0), or by job descriptors on the submission
+ * ring and a write on the doorbell register (see IP_SQ_OFFSET in
+ * app.h). The jobs of the ring are run back to back and reported on
+ * the completion ring with a single (coalesced) interrupt request.
+ * 
  * Version 1.0:
  *   Author: unknown
  *   Date: unknown
@@ -38,6 +44,11 @@
 // Include your libraries here:
 #include "../sw/app.h"
 
+// Activations and profiler of the SystemC processes (simulation only, see tb/sim_stats.h and tb/sc_profile.h):
+#ifndef __SYNTHESIS__
+#include "../tb/sim_stats.h"
+#endif
+
 
 // Parameters:
 #define AXI_ADDR_WIDTH 32 // width of the AXI address bus
@@ -81,6 +92,7 @@ SC_MODULE (myip)
 
     /* Auxiliar (member) functions: */
     // Declare here auxiliar functions:
+    bool ring_irq_level(); // Coalesced interrupt request of the completion ring
 
 
     /* Processes: */
@@ -89,9 +101,14 @@ SC_MODULE (myip)
 
     // Declare here other processes:
 
+#ifndef __SYNTHESIS__
+    SIM_STATS_WAIT_WRAPPERS
+#endif
+
 
     /* Internal signals: */
     // Add here internal signals:
+    sc_signal<bool> ring_busy; // Jobs pending on the submission ring (the IP must be clocked)
 
 
     /* Internal data (variables): */
@@ -99,17 +116,23 @@ SC_MODULE (myip)
     sc_signal<unsigned> register0;
     unsigned registers[16];
 
+    // Job rings (see IP_SQ_OFFSET in app.h). The indices are registers[IP_REG_*].
+    // Like the registers and the buffers, they are only written by write_cthread:
+    unsigned sq[IP_RING_SIZE]; // Submission ring
+    unsigned cq[IP_RING_SIZE]; // Completion ring
+
     // For large arrays, they need to be described as static arrays for HLS.
     // However, they may lead to stack overflow problems during simulation.
     // Hence, they may be described as dynamic arrays for simulation:
+    // There are IP_SLOTS buffers of every kind, one after the other (slot 0 for the single job mode):
 #ifdef __SYNTHESIS__
-    char inbuff[RFILE_SIZE]; // input buffer
-    char outbuff[WFILE_SIZE]; // output buffer
+    char inbuff[IPIN_SIZE*IP_SLOTS]; // input buffers
+    char outbuff[IPOUT_SIZE*IP_SLOTS]; // output buffers
 #endif
 
 #ifndef __SYNTHESIS__
-    char *inbuff; // input buffer
-    char *outbuff; // output buffer
+    char *inbuff; // input buffers
+    char *outbuff; // output buffers
 #endif
 
     // Add here internal variables:
@@ -119,8 +142,8 @@ SC_MODULE (myip)
     SC_CTOR(myip) //: Initialize/construct your submodules and internal signals and data here
     {
 #ifndef __SYNTHESIS__
-        inbuff = new char[RFILE_SIZE];
-        outbuff = new char[WFILE_SIZE];
+        inbuff = new char[IPIN_SIZE*IP_SLOTS];
+        outbuff = new char[IPOUT_SIZE*IP_SLOTS];
 #endif
 
         // Register functions as a clock threads:
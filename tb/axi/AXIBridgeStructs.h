@@ -12,9 +12,9 @@ struct AXI_Signals {
     sc_signal<bool > rnw;
     sc_signal<bool > busy;
     sc_signal<bool > done;
-    sc_signal<sc_uint<32> > address;
-    sc_signal<sc_uint<32> > write_data;
-    sc_signal<sc_uint<32> > read_data;
+    sc_signal<axi_tb_word_type > address;
+    sc_signal<axi_tb_word_type > write_data;
+    sc_signal<axi_tb_word_type > read_data;
 
     sc_signal<bool > interrupt_request;
 
@@ -1,10 +1,29 @@
 #ifndef AXIPARAMETERS_H
 #define AXIPARAMETERS_H
 
+#include <systemc.h>
+#include <inttypes.h>
+
 class AXIParameters {
 public:
     static const int BYTES = 4;
     static const int BITWIDTH = BYTES * 8;
 };
 
+/*
+ * Types of the signals and states of the testbench side models (the
+ * AXI bridge, the AXI master and its channel models). When compiled
+ * with AXI_TB_NATIVE_TYPES (make NATIVE_TYPES=1), they are native
+ * integers, which are much cheaper to read, write and compare than
+ * sc_uint. The AXI4-Lite pins (the ports connected to the AXISlave)
+ * keep their sc_uint types in both cases.
+ */
+#ifdef AXI_TB_NATIVE_TYPES
+typedef uint32_t axi_tb_word_type; // Addresses and data
+typedef uint8_t axi_tb_fsm_type; // States of the FSMs
+#else
+typedef sc_uint<32> axi_tb_word_type;
+typedef sc_uint<3> axi_tb_fsm_type;
+#endif
+
 #endif
@@ -19,17 +19,19 @@
  */
 
 #include "axiBridge.h"
+#include "../sim_stats.h"
 
 extern "C" {
-void write_transaction(int a, int d);
-void read_transaction(int a);
+void write_transaction(int a, int d, long cycle);
+void read_transaction(int a, int d, long cycle);
+void irq_transaction(long cycle);
 }
 
 
 using namespace std;
 
 AXIBridge::AXIBridge(sc_core::sc_module_name name, bool big_endian, sc_time &clock_cycle) :
-        Module(name), big_endian(big_endian), pl(0) {
+        Module(name), big_endian(big_endian), pl(0), recorder(NULL) {
     rw_socket.register_b_transport(this, &AXIBridge::b_transport);
 
     SC_THREAD(axiBusHandling);
@@ -38,6 +40,10 @@ AXIBridge::AXIBridge(sc_core::sc_module_name name, bool big_endian, sc_time &clo
     SC_THREAD(updateirq);
     reset_signal_is(resetn, false);
 
+    SC_METHOD(record_reset);
+    sensitive << resetn.neg();
+    dont_initialize();
+
     clk_cycle = clock_cycle;
 
 }
@@ -45,55 +51,79 @@ AXIBridge::AXIBridge(sc_core::sc_module_name name, bool big_endian, sc_time &clo
 void AXIBridge::axiBusHandling() {
     while (true) {
         wait(request);
+        SIM_STATS_ACTIVATION();
         //std::cout << "\tbusHandling at " << sc_time_stamp() << " got request " << std::endl;
-        if (pl->get_command() == tlm::TLM_WRITE_COMMAND) {
-            // write data
-            if (pl->get_data_length() == 1) {
-                write_data.write((uint32_t) *(uint8_t*) pl->get_data_ptr());
-#ifndef COSIM_SYSTEMC
-write_transaction(pl->get_address()+SYS_AXI_BASE, (uint32_t) *(uint8_t*) pl->get_data_ptr());
-#endif
-            } else {
-                write_data.write(*(uint32_t*) pl->get_data_ptr());
+        // A payload of N words (e.g. a burst of the DMA controller) is sent as N
+        // consecutive AXI4-Lite transactions, without going back to the initiator:
+        unsigned beats = pl->get_data_length() > 4 ? pl->get_data_length() / 4 : 1;
+        for (unsigned i = 0; i < beats; ++i)
+            axiTransaction(pl->get_command(), pl->get_address() + 4 * i, pl->get_data_ptr() + 4 * i,
+                    beats > 1 ? 4 : pl->get_data_length());
+        pl->set_command(tlm::TLM_IGNORE_COMMAND);
+        //std::cout << "\tbusHandling at " << sc_time_stamp() << " notify request_done " << std::endl;
+        request_done.notify();
+    }
+}
+
+void AXIBridge::axiTransaction(tlm::tlm_command command, uint32_t offset, unsigned char *data, unsigned length) {
+    sc_time start = sc_time_stamp();
+    if (command == tlm::TLM_WRITE_COMMAND) {
+        ++SimStats::axi_writes;
+        // write data (a byte or half-word is zero extended, only 'length' bytes of the payload are read)
+        uint32_t value = length == 1 ? *(uint8_t*) data : length == 2 ? *(uint16_t*) data : *(uint32_t*) data;
+        write_data.write(value);
 #ifndef COSIM_SYSTEMC
-write_transaction(pl->get_address()+SYS_AXI_BASE, *(uint32_t*) pl->get_data_ptr());
+write_transaction(offset+SYS_AXI_BASE, value, (long) (start / clk_cycle));
 #endif
-            }
-            address.write(pl->get_address()+SYS_AXI_BASE);
-            rnw.write(false);
-            go.write(true);
+        address.write(offset+SYS_AXI_BASE);
+        rnw.write(false);
+        go.write(true);
+        wait(clk_cycle);
+        go.write(false);
+        while (done.read() == false) {
             wait(clk_cycle);
-            go.write(false);
-            while (done.read() == false) {
-                wait(clk_cycle);
-            }
-        } else if (pl->get_command() == tlm::TLM_READ_COMMAND) {
-            // read data
-#ifndef COSIM_SYSTEMC
-	read_transaction(pl->get_address()+SYS_AXI_BASE);
-#endif
-            address.write(pl->get_address()+SYS_AXI_BASE);
-            rnw.write(true);
-            go.write(true);
+        }
+        if (recorder)
+            recorder->transaction(false, address.read(), write_data.read(), start, sc_time_stamp());
+    } else if (command == tlm::TLM_READ_COMMAND) {
+        ++SimStats::axi_reads;
+        // read data
+        address.write(offset+SYS_AXI_BASE);
+        rnw.write(true);
+        go.write(true);
+        wait(clk_cycle);
+        go.write(false);
+        while (done.read() == false) {
             wait(clk_cycle);
-            go.write(false);
-            while (done.read() == false) {
-                wait(clk_cycle);
-            }
-            *(int*) pl->get_data_ptr() = read_data.read();
         }
-        pl->set_command(tlm::TLM_IGNORE_COMMAND);
-        //std::cout << "\tbusHandling at " << sc_time_stamp() << " notify request_done " << std::endl;
-        request_done.notify();
+        // Only 'length' bytes are written on the payload (e.g. a byte element of the DMA controller):
+        uint32_t value = read_data.read();
+        if (length == 1)
+            *(uint8_t*) data = (uint8_t) value;
+        else if (length == 2)
+            *(uint16_t*) data = (uint16_t) value;
+        else
+            *(uint32_t*) data = value;
+#ifndef COSIM_SYSTEMC
+	read_transaction(offset+SYS_AXI_BASE, read_data.read(), (long) (start / clk_cycle));
+#endif
+        if (recorder)
+            recorder->transaction(true, address.read(), read_data.read(), start, sc_time_stamp());
     }
 }
 
 void AXIBridge::b_transport(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time) {
+    // There is a single request for axiBusHandling, and there may be several initiators
+    // (the processor and the DMA controller), so they take turns:
+    bus_mutex.lock();
     while (resetn.read() == 0)
         wait(clk_cycle);
 
     if (payload.get_byte_enable_ptr()) {
         payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+    } else if (payload.get_data_length() > 4 && payload.get_data_length() % 4) {
+        // Bursts are made of whole words:
+        payload.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
     } else {
         pl = &payload;
         request.notify();
@@ -102,13 +132,34 @@ void AXIBridge::b_transport(tlm::tlm_generic_payload &payload, sc_core::sc_time
         //std::cout << "b_transport at " << sc_time_stamp() << " request done " <<std::endl;
         payload.set_response_status(tlm::TLM_OK_RESPONSE);
     }
+    bus_mutex.unlock();
 }
 
 void AXIBridge::updateirq() {
+    bool last_irq = false;
     while (true) {
-        wait(clk_cycle);
+        // The interrupt request is sampled on the clock edges, so a change is
+        // propagated on the next edge (there is no need to wake up on every cycle):
+        wait(interrupt_request.value_changed_event());
+        wait((uint64_t) (sc_time_stamp() / clk_cycle + 1) * clk_cycle - sc_time_stamp());
+        SIM_STATS_ACTIVATION();
+        if (interrupt_request.read() && !last_irq) {
+            ++SimStats::irqs;
+#ifndef COSIM_SYSTEMC
+            irq_transaction((long) (sc_time_stamp() / clk_cycle));
+#endif
+        }
+        last_irq = interrupt_request.read();
         it_signal = interrupt_request.read();
+        if (recorder)
+            recorder->irq(interrupt_request.read(), sc_time_stamp());
         //if (it_signal != 0)
         //std::cout << "interrupt_request read at " <<  it_signal << std::endl;
     }
 }
+
+void AXIBridge::record_reset() {
+    // Resets of the AXI subsystem after the first one (e.g. between the runs of the multi-run mode):
+    if (recorder)
+        recorder->reset(sc_time_stamp());
+}
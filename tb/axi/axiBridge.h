@@ -33,6 +33,9 @@
 #include "AXIBridgeStructs.h"
 #include "axi_lite_master_transaction_model.h"
 #include "../../sw/mmap.h"
+#include "../sc_profile.h"
+#include "../axi_record.h"
+#include "../irq_wakeup.h"
 
 using namespace sc_core;
 using namespace sc_dt;
@@ -47,6 +50,9 @@ public:
     void b_transport(tlm::tlm_generic_payload &payload,
             sc_core::sc_time &delay_time);
 
+    // Log of the AXI transactions (sctop -axi-record, see ../axi_record.h):
+    void set_recorder(AXIRecordWriter *r) { recorder = r; }
+
     sc_in<bool> clk;
     sc_in<bool> resetn;
     sc_in<bool> interrupt_request;
@@ -55,11 +61,11 @@ public:
     sc_out<bool > rnw;
     sc_in<bool > busy;
     sc_in<bool > done;
-    sc_out<sc_uint<32> > address;
-    sc_out<sc_uint<32> > write_data;
-    sc_in<sc_uint<32> > read_data;
+    sc_out<axi_tb_word_type > address;
+    sc_out<axi_tb_word_type > write_data;
+    sc_in<axi_tb_word_type > read_data;
 
-    SignalInitiatorPort<bool> it_signal;
+    IrqSignalPort it_signal;
 
     static const int AXISIZE ; // = 0xFFFFFFFF - 0xc0000000;
     static const int SIZE ; //  = 0x0000FFFF;
@@ -67,13 +73,19 @@ public:
     tlm_utils::simple_target_socket<AXIBridge> rw_socket;
 protected:
     void axiBusHandling();
+    void axiTransaction(tlm::tlm_command command, uint32_t offset, unsigned char *data, unsigned length); // One beat of 1, 2 or 4 bytes
     void updateirq();
+    void record_reset();
+
+    SC_PROFILE_WAIT_WRAPPERS
 
     sc_event request;
     sc_event request_done;
     bool big_endian;
     sc_time clk_cycle;
-    tlm::tlm_generic_payload *pl;
+    tlm::tlm_generic_payload *pl; // Request being served by axiBusHandling
+    sc_mutex bus_mutex; // Held by the initiator of pl
+    AXIRecordWriter *recorder;
 
 };
 
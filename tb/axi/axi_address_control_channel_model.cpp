@@ -1,7 +1,11 @@
 #include "axi_address_control_channel_model.h"
+#include "../sim_stats.h"
+#include "../sc_profile.h"
 
 
 void axi_address_control_channel_model::state_machine_update() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     if (clk.posedge()) {
         if (resetn.read() == 0) {
             current_state.write((acc_fsm_type)(RESET ));
@@ -13,6 +17,8 @@ void axi_address_control_channel_model::state_machine_update() {
     }
 }
 void axi_address_control_channel_model::state_machine_decisions() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     done.write((bool)(0 ));
     address_enable.write((bool)(0 ));
     axvalid.write((bool)(0 ));
@@ -56,8 +62,10 @@ void axi_address_control_channel_model::state_machine_decisions() {
     }
 }
 void axi_address_control_channel_model::comb_assignments() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
 
-    axaddr.write(((address_enable.read() == 1)) ? address.read()  : sc_uint<32>(0));
+    axaddr.write(((address_enable.read() == 1)) ? sc_uint<32>(address.read())  : sc_uint<32>(0));
 
 }
 
@@ -2,13 +2,18 @@
 #define AXI_ADDRESS_CONTROL_CHANNEL_MODEL_H
 
 #include <systemc.h>
+#include "AXIParameters.h"
 #undef COMPLETE
 #define RESET				0
 #define IDLE				1
 #define RUNNING				2
 #define COMPLETE			3
 
+#ifdef AXI_TB_NATIVE_TYPES
+typedef axi_tb_fsm_type acc_fsm_type;
+#else
 typedef sc_uint<2> acc_fsm_type;
+#endif
 
 SC_MODULE(axi_address_control_channel_model) {
 
@@ -16,7 +21,7 @@ SC_MODULE(axi_address_control_channel_model) {
     sc_in<bool >  resetn;
     sc_in<bool >  go;
     sc_out<bool > done;
-    sc_in<sc_uint<32> >  address;
+    sc_in<axi_tb_word_type >  address;
     sc_out<sc_uint<32> > axaddr;
     sc_out<bool > axvalid;
     sc_in<bool >  axready;
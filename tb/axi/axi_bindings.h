@@ -0,0 +1,87 @@
+/***********************************************************************
+ * axi_bindings.h
+ * Connections of the AXI subsystem to the AXI_Signals, shared by the
+ * SubSystem of sctop (top.cpp), the hardware simulator of the
+ * partitioned simulation (hwsim) and the replay harness (axi_replay),
+ * so the three of them build the same AXI bus:
+ *  - bind_axi_driver: the module that runs the transactions on the AXI
+ *    master (AXIBridge, or an AXIDriver: HWServer or AXIReplayer),
+ *  - bind_axi_master: the AXI4-Lite master,
+ *  - bind_axi_slave: an AXI4-Lite slave (e.g. the AXISlave of the IP).
+ * The clock and reset ports are bound by the caller, because they are
+ * not the same signals in every simulator (e.g. the gated clock of
+ * -idle-skip in sctop).
+ */
+
+#ifndef AXI_BINDINGS_H_
+#define AXI_BINDINGS_H_
+
+#include "AXIBridgeStructs.h"
+#include "axi_lite_master_transaction_model.h"
+
+template<class Driver>
+void bind_axi_driver(Driver &driver, AXI_Signals &signals) {
+    driver.interrupt_request(signals.interrupt_request);
+    driver.go(signals.go);
+    driver.rnw(signals.rnw);
+    driver.busy(signals.busy);
+    driver.done(signals.done);
+    driver.address(signals.address);
+    driver.write_data(signals.write_data);
+    driver.read_data(signals.read_data);
+}
+
+inline void bind_axi_master(axi_lite_master_transaction_model &master, AXI_Signals &signals) {
+    master.go(signals.go);
+    master.rnw(signals.rnw);
+    master.busy(signals.busy);
+    master.done(signals.done);
+    master.address(signals.address);
+    master.write_data(signals.write_data);
+    master.read_data(signals.read_data);
+
+    master.m_axi_lite_arready(signals.axi_lite_arready);
+    master.m_axi_lite_arvalid(signals.axi_lite_arvalid);
+    master.m_axi_lite_araddr(signals.axi_lite_araddr);
+    master.m_axi_lite_rready(signals.axi_lite_rready);
+    master.m_axi_lite_rvalid(signals.axi_lite_rvalid);
+    master.m_axi_lite_rdata(signals.axi_lite_rdata);
+    master.m_axi_lite_rresp(signals.axi_lite_rresp);
+    master.m_axi_lite_awready(signals.axi_lite_awready);
+    master.m_axi_lite_awvalid(signals.axi_lite_awvalid);
+    master.m_axi_lite_awaddr(signals.axi_lite_awaddr);
+    master.m_axi_lite_wready(signals.axi_lite_wready);
+    master.m_axi_lite_wvalid(signals.axi_lite_wvalid);
+    master.m_axi_lite_wdata(signals.axi_lite_wdata);
+    master.m_axi_lite_wstrb(signals.axi_lite_wstrb);
+    master.m_axi_lite_bready(signals.axi_lite_bready);
+    master.m_axi_lite_bvalid(signals.axi_lite_bvalid);
+    master.m_axi_lite_bresp(signals.axi_lite_bresp);
+}
+
+// A template, because the slave may be a SystemC model or a foreign module (RTL simulation):
+template<class Slave>
+void bind_axi_slave(Slave &slave, AXI_Signals &signals) {
+    slave.interrupt_request(signals.interrupt_request);
+    slave.s_axi_arready(signals.axi_lite_arready);
+    slave.s_axi_arvalid(signals.axi_lite_arvalid);
+    slave.s_axi_araddr(signals.axi_lite_araddr);
+    slave.s_axi_arprot(signals.axi_lite_arprot);
+    slave.s_axi_rready(signals.axi_lite_rready);
+    slave.s_axi_rvalid(signals.axi_lite_rvalid);
+    slave.s_axi_rdata(signals.axi_lite_rdata);
+    slave.s_axi_rresp(signals.axi_lite_rresp);
+    slave.s_axi_awaddr(signals.axi_lite_awaddr);
+    slave.s_axi_awprot(signals.axi_lite_awprot);
+    slave.s_axi_awvalid(signals.axi_lite_awvalid);
+    slave.s_axi_awready(signals.axi_lite_awready);
+    slave.s_axi_wdata(signals.axi_lite_wdata);
+    slave.s_axi_wstrb(signals.axi_lite_wstrb);
+    slave.s_axi_wvalid(signals.axi_lite_wvalid);
+    slave.s_axi_wready(signals.axi_lite_wready);
+    slave.s_axi_bresp(signals.axi_lite_bresp);
+    slave.s_axi_bvalid(signals.axi_lite_bvalid);
+    slave.s_axi_bready(signals.axi_lite_bready);
+}
+
+#endif
@@ -0,0 +1,40 @@
+/***********************************************************************
+ * axi_driver.cpp
+ * Base module of the AXI transactions without the TLM bus. See
+ * axi_driver.h.
+ */
+
+#include "axi_driver.h"
+#include "../sim_stats.h"
+
+AXIDriver::AXIDriver(sc_module_name name, const sc_time &clock_cycle) :
+        sc_module(name), clk("CLK"), resetn("RESETN"), clk_cycle(clock_cycle), transactions(0) {
+}
+
+void AXIDriver::reset() {
+    resetn.write(false);
+    wait(2 * clk_cycle);
+    resetn.write(true);
+}
+
+uint32_t AXIDriver::transaction(bool read, uint32_t addr, uint32_t data, unsigned length) {
+    uint32_t mask = length == 1 ? 0xFF : length == 2 ? 0xFFFF : 0xFFFFFFFF;
+
+    // Same protocol as AXIBridge::axiTransaction():
+    if (read) {
+        ++SimStats::axi_reads;
+        rnw.write(true);
+    } else {
+        ++SimStats::axi_writes;
+        write_data.write(data & mask);
+        rnw.write(false);
+    }
+    address.write(addr);
+    go.write(true);
+    wait(clk_cycle);
+    go.write(false);
+    while (done.read() == false)
+        wait(clk_cycle);
+    ++transactions;
+    return read ? (uint32_t) read_data.read() & mask : 0;
+}
@@ -0,0 +1,48 @@
+/***********************************************************************
+ * axi_driver.h
+ * Base SystemC module of the modules that run AXI transactions on the
+ * AXI master (axi_lite_master_transaction_model) without the TLM bus:
+ * the server of the hardware simulator (../hwsim/hw_server.h) and the
+ * replay harness (../replay/axi_replayer.h). It has the ports of the
+ * master side of the AXI_Signals (see axi_bindings.h), the reset of
+ * the AXI subsystem and a single implementation of the handshake of
+ * a transaction, the same one as AXIBridge::axiTransaction().
+ */
+
+#ifndef AXI_DRIVER_H_
+#define AXI_DRIVER_H_
+
+#include <systemc.h>
+#include "AXIParameters.h"
+
+class AXIDriver: public sc_module {
+public:
+    sc_in<bool> clk;
+    sc_out<bool> resetn;
+    sc_in<bool> interrupt_request;
+
+    sc_out<bool> go;
+    sc_out<bool> rnw;
+    sc_in<bool> busy;
+    sc_in<bool> done;
+    sc_out<axi_tb_word_type > address;
+    sc_out<axi_tb_word_type > write_data;
+    sc_in<axi_tb_word_type > read_data;
+
+    uint64_t get_transactions() const { return transactions; }
+
+protected:
+    AXIDriver(sc_module_name name, const sc_time &clock_cycle);
+
+    // Reset of the AXI subsystem (two clock cycles):
+    void reset();
+    // Write 'data' or read at 'addr' (the address of the AXI bus). Only 'length' bytes
+    // (1, 2 or 4) are written or read, e.g. a byte element of the DMA controller.
+    // It returns the data read (0 for a write):
+    uint32_t transaction(bool read, uint32_t addr, uint32_t data, unsigned length);
+
+    sc_time clk_cycle;
+    uint64_t transactions;
+};
+
+#endif
@@ -1,7 +1,11 @@
 #include "axi_lite_master_transaction_model.h"
+#include "../sim_stats.h"
+#include "../sc_profile.h"
 using namespace std;
 
 void axi_lite_master_transaction_model::state_machine_update() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     if (m_axi_lite_aclk.posedge()) {
         if (m_axi_lite_aresetn.read() == 0) {
             current_state.write((lmt_fsm_type)(RESET ));
@@ -13,8 +17,10 @@ void axi_lite_master_transaction_model::state_machine_update() {
     }
 }
 void axi_lite_master_transaction_model::state_machine_decisions() {
-    write_channel_data.write((sc_uint<32>)(write_data.read() ));
-    transaction_address.write((sc_uint<32>)(address.read() ));
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
+    write_channel_data.write(write_data.read());
+    transaction_address.write(address.read());
     start_read_transaction.write((bool)(0 ));
     start_write_transaction.write((bool)(0 ));
     send_write_data.write((bool)(0 ));
@@ -77,8 +83,10 @@ void axi_lite_master_transaction_model::state_machine_decisions() {
     }
 }
 void axi_lite_master_transaction_model::comb_assignments() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
 
-    read_data.write((sc_uint<32>)(read_channel_data.read() ));
+    read_data.write(read_channel_data.read());
     resetn.write((bool)(m_axi_lite_aresetn.read() ));
 
 }
@@ -14,7 +14,11 @@
 #define COMPLETE			4
 
 
+#ifdef AXI_TB_NATIVE_TYPES
+typedef axi_tb_fsm_type lmt_fsm_type;
+#else
 typedef sc_uint<3> lmt_fsm_type;
+#endif
 
 SC_MODULE(axi_lite_master_transaction_model) {
 
@@ -22,9 +26,9 @@ SC_MODULE(axi_lite_master_transaction_model) {
     sc_in<bool >  rnw;
     sc_out<bool > busy;
     sc_out<bool > done;
-    sc_in<sc_uint<32> >  address;
-    sc_in<sc_uint<32> >  write_data;
-    sc_out<sc_uint<32> > read_data;
+    sc_in<axi_tb_word_type >  address;
+    sc_in<axi_tb_word_type >  write_data;
+    sc_out<axi_tb_word_type > read_data;
     sc_in<bool >  m_axi_lite_aclk;
     sc_in<bool >  m_axi_lite_aresetn;
     sc_in<bool >  m_axi_lite_arready;
@@ -46,9 +50,9 @@ SC_MODULE(axi_lite_master_transaction_model) {
     sc_in<sc_uint<2> >  m_axi_lite_bresp;
 
     sc_signal<lmt_fsm_type > current_state,next_state;
-    sc_signal<sc_uint<32> > read_channel_data;
-    sc_signal<sc_uint<32> > write_channel_data;
-    sc_signal<sc_uint<32> > transaction_address;
+    sc_signal<axi_tb_word_type > read_channel_data;
+    sc_signal<axi_tb_word_type > write_channel_data;
+    sc_signal<axi_tb_word_type > transaction_address;
     sc_signal<bool > start_read_transaction;
     sc_signal<bool > start_write_transaction;
 
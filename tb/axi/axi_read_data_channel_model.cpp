@@ -1,7 +1,11 @@
 #include "axi_read_data_channel_model.h"
+#include "../sim_stats.h"
+#include "../sc_profile.h"
 
 
 void axi_read_data_channel_model::state_machine_update() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     if (clk.posedge()) {
         if (resetn.read() == 0) {
             current_state.write((main_fsm_type)(RESET ));
@@ -13,6 +17,8 @@ void axi_read_data_channel_model::state_machine_update() {
     }
 }
 void axi_read_data_channel_model::state_machine_decisions() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     done.write((bool)(0 ));
 
     switch (current_state.read()) {
@@ -23,7 +29,7 @@ void axi_read_data_channel_model::state_machine_decisions() {
         next_state.write((main_fsm_type)(IDLE ));
     rready.write((bool)(0 ));
         if (rvalid.read() == 1) {
-            if (rresp.read() == (sc_uint<2>)"0b00") {
+            if (rresp.read() == 0) { // OKAY
                 next_state.write((main_fsm_type)(TRANSACTION_OKAY ));
     		done.write((bool)(1 ));
             } else {
@@ -58,8 +64,10 @@ break;
     }
 }
 void axi_read_data_channel_model::comb_assignments() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
 
-    data.write(((rvalid.read() == 1)) ? rdata.read()  : "0x00000000" );
+    data.write(((rvalid.read() == 1)) ? (axi_tb_word_type) rdata.read()  : axi_tb_word_type(0));
 
 }
 
@@ -2,6 +2,7 @@
 #define AXI_READ_DATA_CHANNEL_MODEL_H
 
 #include <systemc.h>
+#include "AXIParameters.h"
 #undef COMPLETE
 #define RESET				0
 #define IDLE				1
@@ -9,7 +10,11 @@
 #define TRANSACTION_ERROR	3
 #define COMPLETE			4
 
+#ifdef AXI_TB_NATIVE_TYPES
+typedef axi_tb_fsm_type main_fsm_type;
+#else
 typedef sc_uint<3> main_fsm_type;
+#endif
 
 SC_MODULE(axi_read_data_channel_model) {
 
@@ -18,7 +23,7 @@ SC_MODULE(axi_read_data_channel_model) {
     sc_in<bool >  read_address_done;
     sc_out<bool >  done;
 
-    sc_out<sc_uint<32> > data;
+    sc_out<axi_tb_word_type > data;
     sc_in<sc_uint<32> >  rdata;
     sc_in<sc_uint<2> >  rresp;
     sc_in<bool >  rvalid;
@@ -1,7 +1,11 @@
 #include "axi_write_data_channel_model.h"
+#include "../sim_stats.h"
+#include "../sc_profile.h"
 
 
 void axi_write_data_channel_model::state_machine_update() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     if (clk.posedge()) {
         if (resetn.read() == 0) {
             current_state.write((wdc_fsm_type)(RESET ));
@@ -13,7 +17,9 @@ void axi_write_data_channel_model::state_machine_update() {
     }
 }
 void axi_write_data_channel_model::state_machine_decisions() {
-    wstrb.write((sc_uint<4>)("0b0000" ));
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
+    wstrb.write(sc_uint<4>(0x0));
     wvalid.write((bool)(0 ));
     output_data.write((bool)(0 ));
     done.write((bool)(0 ));
@@ -30,7 +36,7 @@ void axi_write_data_channel_model::state_machine_decisions() {
         } break;
     case RUNNING :
         output_data.write((bool)(1 ));
-        wstrb.write((sc_uint<4>)("0b1111" ));
+        wstrb.write(sc_uint<4>(0xF));
         wvalid.write((bool)(1 ));
         if (wready.read() == 1) {
             next_state.write((wdc_fsm_type)(COMPLETE ));
@@ -55,8 +61,10 @@ void axi_write_data_channel_model::state_machine_decisions() {
     }
 }
 void axi_write_data_channel_model::comb_assignments() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
 
-    wdata.write(((output_data.read() == 1)) ? data.read()  : "0x00000000" );
+    wdata.write(((output_data.read() == 1)) ? sc_uint<32>(data.read())  : sc_uint<32>(0));
 
 }
 
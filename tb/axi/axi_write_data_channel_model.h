@@ -2,6 +2,7 @@
 #define AXI_WRITE_DATA_CHANNEL_MODEL_H
 
 #include <systemc.h>
+#include "AXIParameters.h"
 #undef COMPLETE
 #define RESET				0
 #define IDLE				1
@@ -9,13 +10,17 @@
 #define COMPLETE			3
 
 
+#ifdef AXI_TB_NATIVE_TYPES
+typedef axi_tb_fsm_type wdc_fsm_type;
+#else
 typedef sc_uint<2> wdc_fsm_type;
+#endif
 
 SC_MODULE(axi_write_data_channel_model) {
 
     sc_in<bool >  clk;
     sc_in<bool >  resetn;
-    sc_in<sc_uint<32> >  data;
+    sc_in<axi_tb_word_type >  data;
     sc_in<bool >  go;
     sc_out<bool > done;
     sc_out<sc_uint<32> > wdata;
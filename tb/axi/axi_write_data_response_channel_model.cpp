@@ -1,7 +1,11 @@
 #include "axi_write_data_response_channel_model.h"
+#include "../sim_stats.h"
+#include "../sc_profile.h"
 
 
 void axi_write_data_response_channel_model::state_machine_update() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     if (clk.posedge()) {
         if (resetn.read() == 0) {
             current_state.write((main_fsm_type)(reset ));
@@ -13,6 +17,8 @@ void axi_write_data_response_channel_model::state_machine_update() {
     }
 }
 void axi_write_data_response_channel_model::state_machine_decisions() {
+    SIM_STATS_ACTIVATION();
+    SC_PROFILE_METHOD();
     bready.write((bool)(0 ));
 
     switch (current_state.read()) {
@@ -23,7 +29,7 @@ void axi_write_data_response_channel_model::state_machine_decisions() {
         next_state.write((main_fsm_type)(idle ));
         bready.write((bool)(1 ));
         if (bvalid.read() == 1) {
-            if (bresp.read() == (sc_uint<2>)"0b00") {
+            if (bresp.read() == 0) { // OKAY
                 next_state.write((main_fsm_type)(success ));
             } else {
                 next_state.write((main_fsm_type)(error ));
@@ -0,0 +1,145 @@
+/***********************************************************************
+ * axi_record.cpp
+ * Log of the AXI transactions of a simulation. See axi_record.h.
+ */
+
+#include "axi_record.h"
+#include <cstring>
+
+// Size of an entry on the file: kind (1), padding (3), time (8), cycles (4), address (4), data (4)
+static const unsigned ENTRY_SIZE = 24;
+static const unsigned MAGIC_SIZE = 8;
+
+static void put(unsigned char *p, uint64_t v, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; ++i, v >>= 8)
+        p[i] = (unsigned char) v;
+}
+
+static uint64_t get(const unsigned char *p, unsigned bytes) {
+    uint64_t v = 0;
+    for (unsigned i = bytes; i > 0; --i)
+        v = (v << 8) | p[i - 1];
+    return v;
+}
+
+static uint64_t to_ps(const sc_time &t) {
+    return (uint64_t) (t.to_seconds() * 1e12 + 0.5);
+}
+
+AXIRecordWriter::AXIRecordWriter() :
+        file(NULL), entries(0) {
+}
+
+AXIRecordWriter::~AXIRecordWriter() {
+    close();
+}
+
+bool AXIRecordWriter::open(const char *file_name, const sc_time &clock_cycle) {
+    close();
+    file = fopen(file_name, "wb");
+    if (!file)
+        return false;
+    clk_cycle = clock_cycle;
+    entries = 0;
+
+    unsigned char header[MAGIC_SIZE + 8];
+    memcpy(header, AXI_RECORD_MAGIC, MAGIC_SIZE);
+    put(header + MAGIC_SIZE, to_ps(clock_cycle), 8);
+    fwrite(header, sizeof(header), 1, file);
+    return true;
+}
+
+void AXIRecordWriter::close() {
+    if (file)
+        fclose(file);
+    file = NULL;
+}
+
+void AXIRecordWriter::write(const AXIRecordEntry &entry) {
+    unsigned char buffer[ENTRY_SIZE];
+    memset(buffer, 0, sizeof(buffer));
+    buffer[0] = entry.kind;
+    put(buffer + 4, entry.time, 8);
+    put(buffer + 12, entry.cycles, 4);
+    put(buffer + 16, entry.address, 4);
+    put(buffer + 20, entry.data, 4);
+    fwrite(buffer, sizeof(buffer), 1, file);
+    ++entries;
+}
+
+void AXIRecordWriter::transaction(bool read, uint32_t address, uint32_t data, const sc_time &start, const sc_time &end) {
+    if (!file)
+        return;
+    AXIRecordEntry entry;
+    entry.kind = read ? AXIRecordEntry::RECORD_READ : AXIRecordEntry::RECORD_WRITE;
+    entry.time = to_ps(start);
+    entry.cycles = (uint32_t) ((end - start) / clk_cycle + 0.5);
+    entry.address = address;
+    entry.data = data;
+    write(entry);
+}
+
+void AXIRecordWriter::irq(bool level, const sc_time &time) {
+    if (!file)
+        return;
+    AXIRecordEntry entry;
+    entry.kind = AXIRecordEntry::RECORD_IRQ;
+    entry.time = to_ps(time);
+    entry.cycles = 0;
+    entry.address = 0;
+    entry.data = level;
+    write(entry);
+}
+
+void AXIRecordWriter::reset(const sc_time &time) {
+    if (!file)
+        return;
+    AXIRecordEntry entry;
+    entry.kind = AXIRecordEntry::RECORD_RESET;
+    entry.time = to_ps(time);
+    entry.cycles = 0;
+    entry.address = 0;
+    entry.data = 0;
+    write(entry);
+}
+
+AXIRecordReader::AXIRecordReader() :
+        file(NULL), clock_cycle(0) {
+}
+
+AXIRecordReader::~AXIRecordReader() {
+    close();
+}
+
+bool AXIRecordReader::open(const char *file_name) {
+    close();
+    file = fopen(file_name, "rb");
+    if (!file)
+        return false;
+
+    unsigned char header[MAGIC_SIZE + 8];
+    if (fread(header, sizeof(header), 1, file) != 1 || memcmp(header, AXI_RECORD_MAGIC, MAGIC_SIZE) != 0) {
+        close();
+        return false;
+    }
+    clock_cycle = get(header + MAGIC_SIZE, 8);
+    return true;
+}
+
+void AXIRecordReader::close() {
+    if (file)
+        fclose(file);
+    file = NULL;
+}
+
+bool AXIRecordReader::read(AXIRecordEntry &entry) {
+    unsigned char buffer[ENTRY_SIZE];
+    if (!file || fread(buffer, sizeof(buffer), 1, file) != 1)
+        return false;
+    entry.kind = buffer[0];
+    entry.time = get(buffer + 4, 8);
+    entry.cycles = (uint32_t) get(buffer + 12, 4);
+    entry.address = (uint32_t) get(buffer + 16, 4);
+    entry.data = (uint32_t) get(buffer + 20, 4);
+    return true;
+}
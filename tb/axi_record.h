@@ -0,0 +1,75 @@
+/***********************************************************************
+ * axi_record.h
+ * Log of the AXI transactions of a simulation (sctop -axi-record), to
+ * replay them on the AXI master and the IP without the ISS (see
+ * replay/axi_replay.cpp).
+ *
+ * The log is a binary file: a header (AXI_RECORD_MAGIC and the clock
+ * period in ps) followed by fixed size entries, in the order of the
+ * simulation. Every entry is a transaction done by the AXIBridge (with
+ * its address, the data written or read, its start time and its
+ * duration in clock cycles), a change of the interrupt request seen by
+ * the AXIBridge, or a reset of the AXI subsystem. The integers are
+ * written in little endian, so the log does not depend on the host.
+ */
+
+#ifndef AXI_RECORD_H_
+#define AXI_RECORD_H_
+
+#include <inttypes.h>
+#include <cstdio>
+#include <systemc.h>
+
+#define AXI_RECORD_MAGIC "AXIREC01"
+
+struct AXIRecordEntry {
+    enum { RECORD_WRITE, RECORD_READ, RECORD_IRQ, RECORD_RESET }; // Kinds of entries (RESET is a macro of the AXI models)
+    uint8_t kind;
+    uint64_t time; // Start of the transaction, or time of the IRQ change or reset (ps)
+    uint32_t cycles; // Duration of the transaction (clock cycles)
+    uint32_t address; // Address on the AXI bus (with SYS_AXI_BASE)
+    uint32_t data; // Data written or read, or level of the IRQ
+};
+
+class AXIRecordWriter {
+public:
+    AXIRecordWriter();
+    ~AXIRecordWriter();
+
+    bool open(const char *file_name, const sc_time &clock_cycle);
+    void close();
+    bool is_open() const { return file != NULL; }
+
+    void transaction(bool read, uint32_t address, uint32_t data, const sc_time &start, const sc_time &end);
+    void irq(bool level, const sc_time &time);
+    void reset(const sc_time &time);
+
+    uint64_t get_entries() const { return entries; }
+
+private:
+    void write(const AXIRecordEntry &entry);
+
+    FILE *file;
+    sc_time clk_cycle;
+    uint64_t entries;
+};
+
+class AXIRecordReader {
+public:
+    AXIRecordReader();
+    ~AXIRecordReader();
+
+    // Returns false if the file cannot be opened or it is not an AXI log:
+    bool open(const char *file_name);
+    void close();
+    // Next entry of the log (false at the end of the log):
+    bool read(AXIRecordEntry &entry);
+
+    uint64_t get_clock_cycle() const { return clock_cycle; } // In ps
+
+private:
+    FILE *file;
+    uint64_t clock_cycle;
+};
+
+#endif
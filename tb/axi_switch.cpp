@@ -0,0 +1,38 @@
+/***********************************************************************
+ * axi_switch.cpp
+ * TLM router between the TLM bus and the IPs on the AXI bus. See
+ * axi_switch.h.
+ */
+
+#include "axi_switch.h"
+
+AXISwitch::AXISwitch(sc_core::sc_module_name name) :
+        Module(name), current_mode(PIN_LEVEL), requested_mode(PIN_LEVEL), transactions(0),
+        switch_after(0), switch_after_mode(PIN_LEVEL), listener(NULL) {
+    rw_socket.register_b_transport(this, &AXISwitch::b_transport);
+}
+
+void AXISwitch::b_transport(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time) {
+    if (switch_after && transactions >= switch_after) {
+        requested_mode = switch_after_mode;
+        switch_after = 0;
+    }
+
+    // No transaction is in flight here, so it is a safe point to change the mode if the listener agrees:
+    if (requested_mode != current_mode && (!listener || listener->switch_ready(current_mode, requested_mode))) {
+        if (listener)
+            listener->switching(current_mode, requested_mode);
+        current_mode = requested_mode;
+    }
+    // A burst of N words counts as N AXI transactions (see the AXI bridge):
+    transactions += payload.get_data_length() > 4 ? payload.get_data_length() / 4 : 1;
+
+    // The addresses are forwarded unchanged (offsets to SYS_AXI_BASE):
+    if (current_mode == UNTIMED)
+        untimed_socket[0]->b_transport(payload, delay_time);
+    else
+        pin_socket->b_transport(payload, delay_time);
+
+    if (listener)
+        listener->transaction(payload, current_mode);
+}
@@ -0,0 +1,78 @@
+/***********************************************************************
+ * axi_switch.h
+ * TLM router between the TLM bus and the IPs on the AXI bus. It is
+ * bound at SYS_AXI_BASE and forwards every transaction either to the
+ * AXI bridge (cycle level AXI bus and IP) or to the untimed TLM model
+ * of the IP (see ip_model_tlm.h), depending on its mode. The mode can
+ * be changed during the simulation: a requested change is applied
+ * between two transactions, when the listener says it is safe (e.g.
+ * when the IP is not computing), so the state of the IP can be
+ * transferred from one model to the other (see fast_forward.h).
+ */
+
+#ifndef AXI_SWITCH_H_
+#define AXI_SWITCH_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/multi_passthrough_initiator_socket.h>
+#include <libsimsoc/module.hpp>
+
+class AXISwitchListener;
+
+class AXISwitch: public simsoc::Module {
+public:
+    typedef AXISwitch SC_CURRENT_USER_MODULE;
+    AXISwitch(sc_core::sc_module_name name);
+
+    enum mode {
+        PIN_LEVEL, // AXI bridge, AXI bus and IP (cycle level)
+        UNTIMED // TLM model of the IP
+    };
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    // Set the mode immediately (before the simulation starts):
+    void set_mode(mode m) { current_mode = requested_mode = m; }
+    // Change the mode at the next safe point:
+    void request_mode(mode m) { requested_mode = m; }
+    // Change the mode at the next safe point after 'n' transactions (0 disables it):
+    void request_mode_after(uint64_t n, mode m) { switch_after = n; switch_after_mode = m; }
+    mode get_mode() const { return current_mode; }
+    uint64_t get_transactions() const { return transactions; }
+
+    void set_listener(AXISwitchListener *l) { listener = l; }
+
+    tlm_utils::simple_target_socket<AXISwitch> rw_socket; // From the TLM bus
+    tlm_utils::simple_initiator_socket<AXISwitch> pin_socket; // To the AXI bridge
+    // To the TLM model of the IP (unbound if it is not instantiated, the mode must stay PIN_LEVEL):
+    tlm_utils::multi_passthrough_initiator_socket<AXISwitch, 32, tlm::tlm_base_protocol_types, 1,
+            sc_core::SC_ZERO_OR_MORE_BOUND> untimed_socket;
+
+protected:
+    mode current_mode;
+    mode requested_mode;
+    uint64_t transactions; // Number of transactions forwarded
+    uint64_t switch_after;
+    mode switch_after_mode;
+    AXISwitchListener *listener;
+};
+
+/***
+ * Interface of the module that decides when the mode can be changed and
+ * transfers the state of the IP between the models.
+ */
+class AXISwitchListener {
+public:
+    virtual ~AXISwitchListener() {}
+    // Return true if the mode can be changed now:
+    virtual bool switch_ready(AXISwitch::mode from, AXISwitch::mode to) = 0;
+    // Called just before the mode is changed:
+    virtual void switching(AXISwitch::mode from, AXISwitch::mode to) = 0;
+    // Called after every transaction:
+    virtual void transaction(const tlm::tlm_generic_payload &payload, AXISwitch::mode m) {}
+};
+
+#endif
@@ -0,0 +1,93 @@
+/***********************************************************************
+ * axi_trace_monitor.cpp
+ * SystemC module that writes the activity of the AXI bus and the IP as
+ * a timeline. See axi_trace_monitor.h.
+ */
+
+#include "axi_trace_monitor.h"
+#include "../sw/app.h"
+#include "../sw/mmap.h"
+#include <cstdio>
+
+static std::string hex_arg(const char *key, uint32_t value) {
+    char s[64];
+    sprintf(s, "\"%s\": \"0x%08x\"", key, value);
+    return s;
+}
+
+AXITraceMonitor::AXITraceMonitor(sc_module_name name, AXI_Signals &signals, TraceWriter &writer) :
+        clk("CLK"), signals(signals), last_irq(false) {
+    iss.init(&writer, writer.track("ISS"));
+    bridge.init(&writer, writer.track("AXIBridge"));
+    ar.init(&writer, writer.track("AXI AR"));
+    r.init(&writer, writer.track("AXI R"));
+    aw.init(&writer, writer.track("AXI AW"));
+    w.init(&writer, writer.track("AXI W"));
+    b.init(&writer, writer.track("AXI B"));
+    ip.init(&writer, writer.track("myip"));
+
+    iss.begin("run");
+
+    SC_METHOD(monitor);
+    sensitive << clk.pos();
+    dont_initialize();
+}
+
+void AXITraceMonitor::channel(TraceSlice &slice, bool valid, bool ready, const char *name, uint32_t value) {
+    if (valid && !slice.is_open())
+        slice.begin(name, hex_arg("value", value));
+    if (slice.is_open() && (!valid || ready))
+        slice.end();
+}
+
+void AXITraceMonitor::ip_phase(const char *phase) {
+    if (!ip.is_open() || ip.get_name() != phase)
+        ip.begin(phase);
+}
+
+void AXITraceMonitor::monitor() {
+    // AXI bridge (the ISS is blocked during its transactions):
+    if (signals.go.read() && !bridge.is_open()) {
+        uint32_t offset = (uint32_t) signals.address.read() - SYS_AXI_BASE;
+        bool read = signals.rnw.read();
+        iss.end();
+        bridge.begin(read ? "read" : "write", hex_arg("address", signals.address.read()));
+
+        // Phases of the IP:
+        if (!read && offset >= IPIN_OFFSET && offset < IPOUT_OFFSET)
+            ip_phase("load");
+        else if (!read && offset == 0 && (signals.write_data.read() & 0x80))
+            ip_phase("compute");
+        else if (read && offset >= IPOUT_OFFSET && offset < IPOUT_OFFSET + IPOUT_SIZE * 4)
+            ip_phase("drain");
+    } else if (signals.done.read() && bridge.is_open()) {
+        bridge.end();
+        iss.begin("run");
+    }
+
+    // Channels (from VALID to the handshake):
+    channel(ar, signals.axi_lite_arvalid.read(), signals.axi_lite_arready.read(), "AR", signals.axi_lite_araddr.read());
+    channel(r, signals.axi_lite_rvalid.read(), signals.axi_lite_rready.read(), "R", signals.axi_lite_rdata.read());
+    channel(aw, signals.axi_lite_awvalid.read(), signals.axi_lite_awready.read(), "AW", signals.axi_lite_awaddr.read());
+    channel(w, signals.axi_lite_wvalid.read(), signals.axi_lite_wready.read(), "W", signals.axi_lite_wdata.read());
+    channel(b, signals.axi_lite_bvalid.read(), signals.axi_lite_bready.read(), "B", signals.axi_lite_bresp.read());
+
+    // Interrupt request of the IP:
+    bool irq = signals.interrupt_request.read();
+    if (irq && !last_irq)
+        ip_phase("IRQ");
+    else if (!irq && last_irq && ip.get_name() == "IRQ")
+        ip.end();
+    last_irq = irq;
+}
+
+void AXITraceMonitor::finish() {
+    iss.end();
+    bridge.end();
+    ar.end();
+    r.end();
+    aw.end();
+    w.end();
+    b.end();
+    ip.end();
+}
@@ -0,0 +1,49 @@
+/***********************************************************************
+ * axi_trace_monitor.h
+ * SystemC module that watches the AXI bus on every clock cycle and
+ * writes its activity as slices of a timeline (see trace_json.h):
+ *  - ISS: software running between two AXI transactions.
+ *  - AXIBridge: every transaction, from 'go' to 'done'.
+ *  - AR, R, AW, W, B: every AXI channel, from VALID to the handshake.
+ *  - myip: phases of the IP, deduced from the accesses: load (writes to
+ *    the input port), compute (from the start in register 0 to the
+ *    interrupt request), IRQ (interrupt request asserted) and drain
+ *    (reads of the output port).
+ * It is only instantiated when sctop is run with -trace-json.
+ */
+
+#ifndef AXI_TRACE_MONITOR_H_
+#define AXI_TRACE_MONITOR_H_
+
+#include <systemc.h>
+#include "AXIBridgeStructs.h"
+#include "trace_json.h"
+
+SC_MODULE(AXITraceMonitor) {
+public:
+    sc_in<bool> clk;
+
+    typedef AXITraceMonitor SC_CURRENT_USER_MODULE;
+    AXITraceMonitor(sc_module_name name, AXI_Signals &signals, TraceWriter &writer);
+
+    // Close the open slices (at the end of the simulation):
+    void finish();
+
+private:
+    void monitor();
+
+    // Slice of an AXI channel from VALID to the handshake:
+    void channel(TraceSlice &slice, bool valid, bool ready, const char *name, uint32_t value);
+    void ip_phase(const char *phase);
+
+    AXI_Signals &signals;
+
+    TraceSlice iss;
+    TraceSlice bridge;
+    TraceSlice ar, r, aw, w, b;
+    TraceSlice ip;
+
+    bool last_irq;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#####################################################
+#       Benchmark of the SystemC simulation         #
+# It runs sctop on a fixed set of scenarios and     #
+# writes the speed of the simulation of every one   #
+# (wall time, simulated cycles and kHz, delta       #
+# cycles, process activations and peak RSS) on     #
+# bench.json.                                       #
+#                                                   #
+# Usage: sh bench.sh [-o file] [-compare baseline]  #
+#                    [-threshold percent]           #
+# With -compare, the results are compared with a    #
+# previous bench.json and the scenarios that are    #
+# slower than the threshold (10% by default) are    #
+# flagged as regressions (exit status 1).           #
+# The benchmark applications are compiled with      #
+# 'make bench' in the 'sw' directory.               #
+#####################################################
+
+OUT=bench.json
+BASELINE=
+THRESHOLD=10
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -o) OUT="$2"; shift ;;
+        -compare) BASELINE="$2"; shift ;;
+        -threshold) THRESHOLD="$2"; shift ;;
+        *) echo "Unknown option $1"; exit 2 ;;
+    esac
+    shift
+done
+
+# Scenarios: name and elf file
+SCENARIOS="app:../sw/app.elf
+pio_write:../sw/bench/bench_write.elf
+pio_read:../sw/bench/bench_read.elf
+irq_pingpong:../sw/bench/bench_irq.elf"
+
+mkdir -p bench_results
+echo "[" > $OUT
+FIRST=1
+for s in $SCENARIOS; do
+    NAME=${s%%:*}
+    ELF=${s#*:}
+    if [ ! -f $ELF ]; then
+        echo "Missing $ELF (execute 'make bench' in the 'sw' directory)"
+        exit 2
+    fi
+    echo "Running $NAME ($ELF)"
+    ./sctop $ELF -stats bench_results/$NAME.json -stats-name "$NAME" > bench_results/$NAME.log 2>&1
+    if [ ! -f bench_results/$NAME.json ]; then
+        echo "The simulation of $NAME failed (see bench_results/$NAME.log)"
+        exit 2
+    fi
+    [ $FIRST -eq 1 ] || echo "," >> $OUT
+    FIRST=0
+    cat bench_results/$NAME.json >> $OUT
+done
+echo "]" >> $OUT
+echo "Results written on $OUT"
+
+[ -z "$BASELINE" ] && exit 0
+
+# Compare with the baseline. The JSON files have one member per line (see sim_stats.cpp):
+awk -v threshold=$THRESHOLD '
+    function value(line) { sub(/^[^:]*: */, "", line); gsub(/[",]/, "", line); return line }
+    /"name"/ { name = value($0) }
+    /"wall_time_s"/ { if (FILENAME == ARGV[1]) base_wall[name] = value($0); else wall[name] = value($0) }
+    /"sim_cycles"/ { if (FILENAME == ARGV[1]) base_cycles[name] = value($0); else cycles[name] = value($0) }
+    END {
+        status = 0
+        printf "%-14s %12s %12s %9s\n", "scenario", "base wall(s)", "wall(s)", "change"
+        for (n in wall) {
+            if (!(n in base_wall)) { printf "%-14s %12s %12.3f %9s\n", n, "-", wall[n], "new"; continue }
+            change = base_wall[n] > 0 ? 100 * (wall[n] - base_wall[n]) / base_wall[n] : 0
+            flag = ""
+            if (change > threshold) { flag = "  REGRESSION"; status = 1 }
+            if (cycles[n] != base_cycles[n]) flag = flag "  (simulated cycles changed: " base_cycles[n] " -> " cycles[n] ")"
+            printf "%-14s %12.3f %12.3f %8.1f%%%s\n", n, base_wall[n], wall[n], change, flag
+        }
+        exit status
+    }' $BASELINE $OUT
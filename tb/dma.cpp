@@ -0,0 +1,193 @@
+/***********************************************************************
+ * dma.cpp
+ * SystemC module of the DMA controller of the simulation. See dma.h.
+ */
+
+#include "dma.h"
+#include "sim_stats.h"
+#include <cstring>
+
+using namespace std;
+using namespace sc_core;
+
+DMAController::DMAController(sc_module_name name, const sc_time &clock_cycle, uint32_t single_base, uint32_t single_size) :
+        Module(name), clk_cycle(clock_cycle), single_base(single_base), single_size(single_size),
+        desc(0), ctrl(0), status(0), count(0), chains(0), descriptors(0), bytes(0) {
+    rw_socket.register_b_transport(this, &DMAController::b_transport);
+    SC_THREAD(run);
+}
+
+void DMAController::update_irq() {
+    it_signal = (ctrl & DMA_CTRL_IRQ_EN) && (status & (DMA_STATUS_DONE | DMA_STATUS_ERROR));
+}
+
+void DMAController::b_transport(tlm::tlm_generic_payload &payload, sc_time &delay_time) {
+    // Only 32 bit accesses to the registers are supported:
+    if (payload.get_byte_enable_ptr() || payload.get_data_length() != 4) {
+        payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    uint32_t *data = (uint32_t*) payload.get_data_ptr();
+
+    if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        switch (payload.get_address()) {
+        case DMA_DESC_OFFSET:
+            if (!(status & DMA_STATUS_BUSY))
+                desc = *data;
+            break;
+        case DMA_CTRL_OFFSET:
+            if (!(status & DMA_STATUS_BUSY)) {
+                ctrl = *data;
+                if (ctrl & DMA_CTRL_START) {
+                    status = DMA_STATUS_BUSY;
+                    count = 0;
+                    update_irq();
+                    start_event.notify();
+                }
+            }
+            break;
+        case DMA_STATUS_OFFSET:
+            status &= ~(*data & (DMA_STATUS_DONE | DMA_STATUS_ERROR));
+            update_irq();
+            break;
+        default:
+            break;
+        }
+    } else if (payload.get_command() == tlm::TLM_READ_COMMAND) {
+        switch (payload.get_address()) {
+        case DMA_DESC_OFFSET:
+            *data = desc;
+            break;
+        case DMA_STATUS_OFFSET:
+            *data = status;
+            break;
+        case DMA_COUNT_OFFSET:
+            *data = count;
+            break;
+        default:
+            *data = 0;
+            break;
+        }
+    }
+
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+bool DMAController::access(tlm::tlm_command command, uint32_t address, unsigned char *data, uint32_t length,
+        sc_time &delay) {
+    tlm::tlm_generic_payload payload;
+    payload.set_command(command);
+    payload.set_address(address);
+    payload.set_data_ptr(data);
+    payload.set_data_length(length);
+    payload.set_streaming_width(length);
+    payload.set_byte_enable_ptr(NULL);
+    payload.set_dmi_allowed(false);
+    payload.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    bus_socket->b_transport(payload, delay);
+    return payload.get_response_status() == tlm::TLM_OK_RESPONSE;
+}
+
+bool DMAController::transfer(const dma_desc_t &d) {
+    const uint32_t src_size = 1u << (d.flags & 0x3);
+    const uint32_t dst_size = 1u << ((d.flags >> 2) & 0x3);
+    const bool src_fixed = d.flags & DMA_SRC_FIXED;
+    const bool dst_fixed = d.flags & DMA_DST_FIXED;
+    // Bytes, half-words and words only (the size code 3 is reserved):
+    if (src_size > 4 || dst_size > 4)
+        return false;
+    const uint32_t max_elements = BURST_BYTES / max(src_size, dst_size);
+
+    unsigned char src_buffer[BURST_BYTES];
+    unsigned char dst_buffer[BURST_BYTES];
+
+    for (uint32_t done = 0; done < d.count;) {
+        uint32_t n = min(d.count - done, max_elements);
+        uint32_t src = src_fixed ? d.src : d.src + done * src_size;
+        uint32_t dst = dst_fixed ? d.dst : d.dst + done * dst_size;
+        sc_time delay = SC_ZERO_TIME;
+
+        // Read the burst (element by element if the addresses are not consecutive or on the AXI bus):
+        if (src_fixed || is_single(src, src_size)) {
+            for (uint32_t i = 0; i < n; ++i)
+                if (!access(tlm::TLM_READ_COMMAND, src_fixed ? src : src + i * src_size, src_buffer + i * src_size, src_size, delay))
+                    return false;
+        } else if (!access(tlm::TLM_READ_COMMAND, src, src_buffer, n * src_size, delay))
+            return false;
+
+        // Convert the elements (zero extension or truncation, in the byte order of the host):
+        for (uint32_t i = 0; i < n; ++i) {
+            uint32_t value = 0;
+            if (src_size == 1)
+                value = src_buffer[i];
+            else if (src_size == 2) {
+                uint16_t v;
+                memcpy(&v, src_buffer + 2 * i, 2);
+                value = v;
+            } else
+                memcpy(&value, src_buffer + 4 * i, 4);
+            if (dst_size == 1)
+                dst_buffer[i] = (unsigned char) value;
+            else if (dst_size == 2) {
+                uint16_t v = (uint16_t) value;
+                memcpy(dst_buffer + 2 * i, &v, 2);
+            } else
+                memcpy(dst_buffer + 4 * i, &value, 4);
+        }
+
+        // Write the burst:
+        if (dst_fixed || is_single(dst, dst_size)) {
+            for (uint32_t i = 0; i < n; ++i)
+                if (!access(tlm::TLM_WRITE_COMMAND, dst_fixed ? dst : dst + i * dst_size, dst_buffer + i * dst_size, dst_size, delay))
+                    return false;
+        } else if (!access(tlm::TLM_WRITE_COMMAND, dst, dst_buffer, n * dst_size, delay))
+            return false;
+
+        wait(delay + n * clk_cycle);
+        bytes += n * dst_size;
+        done += n;
+    }
+    return true;
+}
+
+void DMAController::run() {
+    while (true) {
+        wait(start_event);
+        SIM_STATS_ACTIVATION();
+        ++chains;
+
+        bool ok = true;
+        uint32_t address = desc;
+        while (address && ok) {
+            // Read the descriptor (one burst):
+            uint32_t words[5];
+            sc_time delay = SC_ZERO_TIME;
+            ok = access(tlm::TLM_READ_COMMAND, address, (unsigned char*) words, sizeof(words), delay);
+            wait(delay + clk_cycle);
+            if (!ok)
+                break;
+            dma_desc_t d;
+            d.next = words[0];
+            d.src = words[1];
+            d.dst = words[2];
+            d.count = words[3];
+            d.flags = words[4];
+
+            ok = transfer(d);
+            if (ok) {
+                ++count;
+                ++descriptors;
+            }
+            address = d.next;
+        }
+
+        status = ok ? DMA_STATUS_DONE : (DMA_STATUS_DONE | DMA_STATUS_ERROR);
+        update_irq();
+    }
+}
+
+void DMAController::report() {
+    if (chains)
+        cout << name() << ": " << chains << " chains, " << descriptors << " descriptors, " << bytes << " bytes written" << endl;
+}
@@ -0,0 +1,77 @@
+/***********************************************************************
+ * dma.h
+ * SystemC module of the DMA controller of the simulation. It has a TLM
+ * target on the TLM bus for its registers (see SYS_DMA_BASE in mmap.h
+ * and the register map in sw/dma.h) and a TLM initiator on the same
+ * bus, so it reaches the RAM, the memories of the files and the AXI
+ * bus like the processor does.
+ *
+ * It runs a chain of descriptors read from RAM. The data are moved in
+ * bursts of up to BURST_BYTES with a single TLM transaction. On the AXI
+ * bus only the bursts of words are kept (the AXI bridge splits them in
+ * AXI4-Lite transactions); there is one transaction per byte or half
+ * word element. Every burst
+ * costs the delay of its transactions plus one clock cycle per element.
+ * At the end of the chain it raises its interrupt request until the
+ * software clears the status.
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <libsimsoc/module.hpp>
+#include "irq_wakeup.h"
+#include <libsimsoc/interfaces/tlm_signal.hpp>
+#include "../sw/dma.h"
+
+class DMAController: public simsoc::Module {
+public:
+    typedef DMAController SC_CURRENT_USER_MODULE;
+    // single_base, single_size: address range without bursts (the AXI bus)
+    DMAController(sc_core::sc_module_name name, const sc_core::sc_time &clock_cycle,
+            uint32_t single_base, uint32_t single_size);
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    // Print the number of chains, descriptors and bytes moved:
+    void report();
+
+    static const uint32_t BURST_BYTES = 256;
+
+    tlm_utils::simple_target_socket<DMAController> rw_socket; // Registers
+    tlm_utils::simple_initiator_socket<DMAController> bus_socket; // Data and descriptors
+    IrqSignalPort it_signal;
+
+protected:
+    void run();
+    // One descriptor. Returns false if a bus transaction failed:
+    bool transfer(const dma_desc_t &desc);
+    // Bus transaction of 'length' bytes at 'address':
+    bool access(tlm::tlm_command command, uint32_t address, unsigned char *data, uint32_t length,
+            sc_core::sc_time &delay);
+    // Elements of 'size' bytes at 'address' must be accessed one by one:
+    bool is_single(uint32_t address, uint32_t size) const { return size != 4 && address - single_base < single_size; }
+    void update_irq();
+
+    sc_core::sc_time clk_cycle;
+    uint32_t single_base;
+    uint32_t single_size;
+    sc_core::sc_event start_event;
+
+    // Registers:
+    uint32_t desc;
+    uint32_t ctrl;
+    uint32_t status;
+    uint32_t count;
+
+    // Statistics:
+    uint64_t chains;
+    uint64_t descriptors;
+    uint64_t bytes;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/***********************************************************************
+ * fast_forward.cpp
+ * Hybrid simulation: untimed IP until a trigger and cycle level IP
+ * afterwards. See fast_forward.h.
+ */
+
+#include "fast_forward.h"
+#include <cstring>
+
+FastForward::FastForward(sc_module_name name, AXISwitch &axi_switch, IPModelTLM &ip_model) :
+        interrupt_request("interrupt_request"), axi_switch(axi_switch), ip_model(ip_model),
+        registers(NULL), nregisters(0), inbuff(NULL), outbuff(NULL), sq(NULL), cq(NULL),
+        enabled(false), trigger_time(SC_ZERO_TIME), switched(false), switch_transactions(0) {
+    SC_THREAD(time_trigger);
+}
+
+void FastForward::set_ip_state(unsigned *r, unsigned n, char *in, char *out, unsigned *s, unsigned *c) {
+    registers = r;
+    nregisters = n;
+    inbuff = in;
+    outbuff = out;
+    sq = s;
+    cq = c;
+}
+
+bool FastForward::enable() {
+    if (!registers || !inbuff || !outbuff || !sq || !cq)
+        return false;
+    enabled = true;
+    axi_switch.set_mode(AXISwitch::UNTIMED);
+    axi_switch.set_listener(this);
+    return true;
+}
+
+void FastForward::set_transaction_trigger(uint64_t n) {
+    if (enabled)
+        axi_switch.request_mode_after(n, AXISwitch::PIN_LEVEL);
+}
+
+void FastForward::set_time_trigger(const sc_time &t) {
+    trigger_time = t;
+}
+
+void FastForward::marker() {
+    if (enabled)
+        axi_switch.request_mode(AXISwitch::PIN_LEVEL);
+}
+
+void FastForward::time_trigger() {
+    if (!enabled || trigger_time == SC_ZERO_TIME)
+        return;
+    wait(trigger_time);
+    axi_switch.request_mode(AXISwitch::PIN_LEVEL);
+}
+
+bool FastForward::switch_ready(AXISwitch::mode from, AXISwitch::mode to) {
+    // Wait until the interrupt requests have been served and the jobs of the submission ring are
+    // finished (the IP is not computing):
+    if (from == AXISwitch::PIN_LEVEL && registers[IP_REG_SQ_HEAD] != registers[IP_REG_SQ_TAIL])
+        return false;
+    return !ip_model.irq && !interrupt_request.read();
+}
+
+void FastForward::transfer_state(AXISwitch::mode to) {
+    unsigned n = nregisters < IPModelTLM::NREGISTERS ? nregisters : IPModelTLM::NREGISTERS;
+    if (to == AXISwitch::PIN_LEVEL) {
+        // From the untimed model to the cycle level IP:
+        memcpy(registers, ip_model.registers, n * sizeof(unsigned));
+        memcpy(inbuff, ip_model.inbuff, IPIN_SIZE * IP_SLOTS);
+        memcpy(outbuff, ip_model.outbuff, IPOUT_SIZE * IP_SLOTS);
+        memcpy(sq, ip_model.sq, sizeof(ip_model.sq));
+        memcpy(cq, ip_model.cq, sizeof(ip_model.cq));
+    } else {
+        // From the cycle level IP to the untimed model:
+        memcpy(ip_model.registers, registers, n * sizeof(unsigned));
+        memcpy(ip_model.inbuff, inbuff, IPIN_SIZE * IP_SLOTS);
+        memcpy(ip_model.outbuff, outbuff, IPOUT_SIZE * IP_SLOTS);
+        memcpy(ip_model.sq, sq, sizeof(ip_model.sq));
+        memcpy(ip_model.cq, cq, sizeof(ip_model.cq));
+    }
+}
+
+void FastForward::switching(AXISwitch::mode from, AXISwitch::mode to) {
+    if (to != AXISwitch::PIN_LEVEL || switched)
+        return;
+
+    transfer_state(to);
+
+    switched = true;
+    switch_time = sc_time_stamp();
+    switch_transactions = axi_switch.get_transactions();
+    std::cout << " FAST-FORWARD: cycle level IP from " << switch_time << " (after "
+            << switch_transactions << " AXI transactions)" << std::endl;
+}
+
+void FastForward::report() {
+    if (!enabled)
+        return;
+    if (switched)
+        std::cout << " FAST-FORWARD: untimed until " << switch_time << " (" << switch_transactions
+                << " AXI transactions), cycle level afterwards" << std::endl;
+    else
+        std::cout << " FAST-FORWARD: the trigger was not reached, the whole simulation was untimed" << std::endl;
+}
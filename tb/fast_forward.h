@@ -0,0 +1,77 @@
+/***********************************************************************
+ * fast_forward.h
+ * Hybrid simulation: the simulation starts with the untimed model of
+ * the IP (see ip_model_tlm.h) to go fast through the boot and the
+ * loading of the data, and it goes on with the cycle level AXI bus and
+ * IP from a trigger on. The trigger may be:
+ *  - a marker written by the software (SYSCTRL_ROI_BEGIN, see
+ *    sw/sysctrl.h),
+ *  - a number of AXI transactions,
+ *  - a simulation time.
+ * At the trigger, the state of the IP (registers and buffers) is
+ * transferred from the untimed model to the cycle level one, at the
+ * next safe point (between two AXI transactions and without a pending
+ * interrupt request).
+ *
+ * The state can also be transferred back from the cycle level IP to the
+ * untimed model (see sampling.h).
+ */
+
+#ifndef FAST_FORWARD_H_
+#define FAST_FORWARD_H_
+
+#include <systemc.h>
+#include "axi_switch.h"
+#include "ip_model_tlm.h"
+
+SC_MODULE(FastForward), public AXISwitchListener {
+public:
+    // Interrupt request of the cycle level IP (it must be low to change the mode):
+    sc_in<bool> interrupt_request;
+
+    typedef FastForward SC_CURRENT_USER_MODULE;
+    FastForward(sc_module_name name, AXISwitch &axi_switch, IPModelTLM &ip_model);
+
+    // State of the cycle level IP (it must have the layout of the untimed model):
+    void set_ip_state(unsigned *registers, unsigned nregisters, char *inbuff, char *outbuff,
+            unsigned *sq, unsigned *cq);
+
+    // Start the simulation with the untimed model. It returns false if the
+    // state of the cycle level IP is not available:
+    virtual bool enable();
+    bool is_enabled() const { return enabled; }
+    // Triggers (besides the software marker):
+    void set_transaction_trigger(uint64_t n);
+    void set_time_trigger(const sc_time &t);
+    // Software marker of the beginning of the region of interest:
+    void marker();
+
+    virtual void report();
+
+    /* AXISwitchListener functions: */
+    bool switch_ready(AXISwitch::mode from, AXISwitch::mode to);
+    void switching(AXISwitch::mode from, AXISwitch::mode to);
+
+protected:
+    void time_trigger(); // Thread of the time trigger
+
+    // Copy the state of the IP from a model to the other:
+    void transfer_state(AXISwitch::mode to);
+
+    AXISwitch &axi_switch;
+    IPModelTLM &ip_model;
+    unsigned *registers;
+    unsigned nregisters;
+    char *inbuff;
+    char *outbuff;
+    unsigned *sq; // Job rings
+    unsigned *cq;
+
+    bool enabled;
+    sc_time trigger_time;
+    bool switched;
+    sc_time switch_time; // Simulation time of the change to the cycle level IP
+    uint64_t switch_transactions; // AXI transactions before the change
+};
+
+#endif
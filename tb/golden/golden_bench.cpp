@@ -0,0 +1,127 @@
+/***********************************************************************
+ * golden_bench.cpp
+ * Runs the golden model of the IP (see ../golden_model.h) on the host
+ * over a whole dataset, so functional results are available without a
+ * cycle level simulation, and reports its throughput.
+ *
+ * The dataset is a binary file with IPIN_SIZE bytes per image. Without
+ * one, random images are generated. Every implementation (AVX2, SSSE3)
+ * is checked against the scalar one.
+ *
+ * Usage: golden_bench [-i dataset.bin] [-o outputs.bin] [-n images]
+ *                     [-isa auto|scalar|ssse3|avx2] [-repeat n]
+ * Compile it with 'make golden' in the 'tb' directory.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <sys/time.h>
+#include "../golden_model.h"
+
+using namespace std;
+
+static double wall_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+static void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-i dataset.bin] [-o outputs.bin] [-n images] [-isa auto|scalar|ssse3|avx2] [-repeat n]\n", program);
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    const char *input_file = NULL;
+    const char *output_file = NULL;
+    unsigned n = 100000;
+    unsigned repeat = 1;
+    golden_isa isa = GOLDEN_AUTO;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-i") && i + 1 < argc)
+            input_file = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            output_file = argv[++i];
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            n = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-repeat") && i + 1 < argc)
+            repeat = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-isa") && i + 1 < argc) {
+            const char *name = argv[++i];
+            if (!strcmp(name, "scalar")) isa = GOLDEN_SCALAR;
+            else if (!strcmp(name, "ssse3")) isa = GOLDEN_SSSE3;
+            else if (!strcmp(name, "avx2")) isa = GOLDEN_AVX2;
+            else if (strcmp(name, "auto")) usage(argv[0]);
+        } else
+            usage(argv[0]);
+    }
+
+    // Load (or generate) the dataset:
+    vector<char> inputs;
+    if (input_file) {
+        FILE *f = fopen(input_file, "rb");
+        if (!f) {
+            fprintf(stderr, "Cannot open %s\n", input_file);
+            return 1;
+        }
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        n = size / IPIN_SIZE;
+        inputs.resize((size_t) n * IPIN_SIZE);
+        if (n == 0 || fread(&inputs[0], IPIN_SIZE, n, f) != n) {
+            fprintf(stderr, "Cannot read the images of %s\n", input_file);
+            fclose(f);
+            return 1;
+        }
+        fclose(f);
+    } else {
+        inputs.resize((size_t) n * IPIN_SIZE);
+        unsigned seed = 12345;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            seed = seed * 1103515245 + 12345;
+            inputs[i] = (char) (seed >> 16);
+        }
+    }
+    vector<char> outputs((size_t) n * IPOUT_SIZE);
+    vector<char> reference((size_t) n * IPOUT_SIZE);
+
+    // Reference outputs:
+    golden_select(GOLDEN_SCALAR);
+    golden_compute_batch(&inputs[0], &reference[0], n);
+
+    // Measure the selected implementation:
+    golden_isa selected = golden_select(isa);
+    double start = wall_time();
+    for (unsigned r = 0; r < repeat; r++)
+        golden_compute_batch(&inputs[0], &outputs[0], n);
+    double wall = wall_time() - start;
+
+    if (memcmp(&outputs[0], &reference[0], outputs.size()) != 0) {
+        fprintf(stderr, "ERROR: the %s implementation differs from the scalar one\n", golden_isa_name(selected));
+        return 1;
+    }
+
+    double images = (double) n * repeat;
+    printf("isa: %s\n", golden_isa_name(selected));
+    printf("images: %.0f\n", images);
+    printf("wall time: %.6f s\n", wall);
+    if (wall > 0)
+        printf("throughput: %.0f images/s (%.2f million images/min)\n", images / wall, images / wall * 60 / 1e6);
+
+    if (output_file) {
+        FILE *f = fopen(output_file, "wb");
+        if (!f || fwrite(&outputs[0], IPOUT_SIZE, n, f) != n) {
+            fprintf(stderr, "Cannot write %s\n", output_file);
+            if (f)
+                fclose(f);
+            return 1;
+        }
+        fclose(f);
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/***********************************************************************
+ * golden_checker.cpp
+ * SystemC module that checks the outputs of the IP (myip) against the
+ * golden model. See golden_checker.h.
+ */
+
+#include "golden_checker.h"
+
+GoldenChecker::GoldenChecker(sc_module_name name) :
+        interrupt_request("interrupt_request"), clk("clk"), ip_busy("ip_busy"), enabled(false), inbuff(NULL), outbuff(NULL),
+        registers(NULL), cq(NULL), checked_tail(0), checks(0), errors(0) {
+    golden = new char[IPOUT_SIZE];
+
+    SC_METHOD(check);
+    sensitive << interrupt_request.pos();
+    dont_initialize();
+
+    SC_METHOD(check_rings);
+    sensitive << clk.pos();
+    dont_initialize();
+}
+
+GoldenChecker::~GoldenChecker() {
+    delete [] golden;
+}
+
+void GoldenChecker::check() {
+    if (!enabled || !inbuff || !outbuff)
+        return;
+
+    // The request of the rings needs completions not reaped by the software, so this one comes from
+    // the single job mode. The IP has updated its outputs before asserting the interrupt request:
+    if (!registers || registers[IP_REG_CQ_TAIL] == registers[IP_REG_CQ_HEAD])
+        check_slots(0, 0);
+}
+
+void GoldenChecker::check_rings() {
+    if (enabled && inbuff && outbuff && registers && cq) {
+        if (registers[IP_REG_CQ_TAIL] < checked_tail)
+            checked_tail = 0; // The IP has been reset (multi-run mode)
+        // The last IP_RING_SIZE jobs at most, the older entries have been overwritten:
+        if (registers[IP_REG_CQ_TAIL] - checked_tail > IP_RING_SIZE)
+            checked_tail = registers[IP_REG_CQ_TAIL] - IP_RING_SIZE;
+        for (; checked_tail != registers[IP_REG_CQ_TAIL]; ++checked_tail) {
+            unsigned job = cq[checked_tail % IP_RING_SIZE];
+            if (IP_JOB_FLAGS(job) & IP_JOB_DONE)
+                check_slots(IP_JOB_IN(job), IP_JOB_OUT(job));
+        }
+    }
+
+    // ip_busy falls after the last completion has been posted, so that one has been checked:
+    if (!ip_busy.read())
+        next_trigger(ip_busy.posedge_event());
+}
+
+void GoldenChecker::check_slots(unsigned in, unsigned out) {
+    golden_compute(inbuff + in * IPIN_SIZE, golden);
+    int first;
+    unsigned diff = golden_compare(outbuff + out * IPOUT_SIZE, golden, &first);
+    checks++;
+    if (diff) {
+        errors++;
+        std::cout << "GOLDEN CHECK ERROR at " << sc_time_stamp() << " (slots " << in << " -> " << out << "): " << diff
+                << " bytes differ, first at " << first
+                << " (IP: " << (int) outbuff[out * IPOUT_SIZE + first] << ", golden: " << (int) golden[first] << ")" << std::endl;
+    }
+}
+
+void GoldenChecker::report() {
+    if (!enabled)
+        return;
+    std::cout << " GOLDEN CHECK: " << checks << " outputs checked, " << errors << " wrong";
+    std::cout << (errors ? " -> FAILED" : (checks ? " -> PASSED" : "")) << std::endl;
+}
@@ -0,0 +1,60 @@
+/***********************************************************************
+ * golden_checker.h
+ * SystemC module that checks the outputs of the IP (myip) against the
+ * golden model (see golden_model.h). On every rising edge of the
+ * interrupt request of the single job mode, the output buffer of the IP
+ * (slot 0) is compared with the golden output of its input buffer.
+ * The jobs of the rings are checked on the clock edge that follows
+ * their completion (when registers[IP_REG_CQ_TAIL] advances), before
+ * the software can reap them and reload their input slot: the output
+ * slot of each of them is compared with the golden output of its input
+ * slot. The clock is only watched while the IP has jobs (ip_busy).
+ *
+ * It needs access to the internal buffers of myip, so it can only be
+ * used with the SystemC model of the IP (not with the RTL ones).
+ */
+
+#ifndef GOLDEN_CHECKER_H_
+#define GOLDEN_CHECKER_H_
+
+#include <systemc.h>
+#include "golden_model.h"
+
+SC_MODULE(GoldenChecker) {
+public:
+    sc_in<bool> interrupt_request;
+    sc_in<bool> clk; // Clock of the IP
+    sc_in<bool> ip_busy; // Jobs pending on the submission ring of the IP
+
+    typedef GoldenChecker SC_CURRENT_USER_MODULE;
+    GoldenChecker(sc_module_name name);
+    ~GoldenChecker();
+
+    // Buffers of the IP to be checked:
+    void set_buffers(const char *in, const char *out) { inbuff = in; outbuff = out; }
+    // Job rings of the IP (registers[IP_REG_*] and completion ring):
+    void set_rings(const unsigned *r, const unsigned *c) { registers = r; cq = c; }
+    void enable(bool e) { enabled = e; }
+    // Print the results of the checks (number of checks and errors):
+    void report();
+
+    unsigned get_checks() const { return checks; }
+    unsigned get_errors() const { return errors; }
+
+private:
+    void check(); // Single job mode
+    void check_rings(); // Jobs of the rings
+    void check_slots(unsigned in, unsigned out);
+
+    bool enabled;
+    const char *inbuff;
+    const char *outbuff;
+    const unsigned *registers;
+    const unsigned *cq;
+    unsigned checked_tail; // Completions already checked
+    char *golden; // Golden output
+    unsigned checks; // Number of outputs checked
+    unsigned errors; // Number of wrong outputs
+};
+
+#endif
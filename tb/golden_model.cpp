@@ -0,0 +1,120 @@
+/***********************************************************************
+ * golden_model.cpp
+ * Golden (reference) model of the computations of the IP (myip). See
+ * golden_model.h.
+ */
+
+#include "golden_model.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GOLDEN_X86
+#include <immintrin.h>
+#endif
+
+/* Reverse copy (what myip does today): out[i] = in[n-1-i] */
+
+static void reverse_scalar(const char *in, char *out, unsigned n) {
+    for (unsigned i = 0; i < n; i++)
+        out[i] = in[n - i - 1];
+}
+
+#ifdef GOLDEN_X86
+// The functions are compiled for the given ISA whatever the flags of the
+// compiler, and they are only called if the host supports it:
+__attribute__((target("ssse3")))
+static void reverse_ssse3(const char *in, char *out, unsigned n) {
+    const __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    unsigned i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (in + n - i - 16));
+        _mm_storeu_si128((__m128i*) (out + i), _mm_shuffle_epi8(v, mask));
+    }
+    for (; i < n; i++)
+        out[i] = in[n - i - 1];
+}
+
+__attribute__((target("avx2")))
+static void reverse_avx2(const char *in, char *out, unsigned n) {
+    // _mm256_shuffle_epi8 works on each 128 bit lane, so the lanes are swapped afterwards:
+    const __m256i mask = _mm256_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                         0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    unsigned i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (in + n - i - 32));
+        v = _mm256_shuffle_epi8(v, mask);
+        v = _mm256_permute2x128_si256(v, v, 1);
+        _mm256_storeu_si256((__m256i*) (out + i), v);
+    }
+    for (; i < n; i++)
+        out[i] = in[n - i - 1];
+}
+#endif
+
+typedef void (*reverse_fn)(const char *in, char *out, unsigned n);
+
+static reverse_fn reverse = 0;
+
+golden_isa golden_select(golden_isa isa) {
+#ifdef GOLDEN_X86
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool ssse3 = __builtin_cpu_supports("ssse3");
+    if (isa == GOLDEN_AUTO)
+        isa = avx2 ? GOLDEN_AVX2 : (ssse3 ? GOLDEN_SSSE3 : GOLDEN_SCALAR);
+    if ((isa == GOLDEN_AVX2 && !avx2) || (isa == GOLDEN_SSSE3 && !ssse3))
+        isa = GOLDEN_SCALAR;
+#else
+    isa = GOLDEN_SCALAR;
+#endif
+
+    switch (isa) {
+#ifdef GOLDEN_X86
+    case GOLDEN_AVX2:
+        reverse = reverse_avx2;
+        break;
+    case GOLDEN_SSSE3:
+        reverse = reverse_ssse3;
+        break;
+#endif
+    default:
+        reverse = reverse_scalar;
+        break;
+    }
+    return isa;
+}
+
+const char *golden_isa_name(golden_isa isa) {
+    switch (isa) {
+    case GOLDEN_AUTO: return "auto";
+    case GOLDEN_SSSE3: return "ssse3";
+    case GOLDEN_AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+void golden_compute(const char *inbuff, char *outbuff) {
+    if (!reverse)
+        golden_select(GOLDEN_AUTO);
+
+    // Same "computations" as myip::write_cthread (a copy of the input in reverse order):
+    reverse(inbuff, outbuff, IPIN_SIZE);
+}
+
+void golden_compute_batch(const char *inputs, char *outputs, unsigned n) {
+    for (unsigned i = 0; i < n; i++)
+        golden_compute(inputs + i * IPIN_SIZE, outputs + i * IPOUT_SIZE);
+}
+
+unsigned golden_compare(const char *outbuff, const char *golden, int *first) {
+    unsigned errors = 0;
+    if (first)
+        *first = -1;
+    for (unsigned i = 0; i < IPOUT_SIZE; i++) {
+        if (outbuff[i] != golden[i]) {
+            if (errors == 0 && first)
+                *first = i;
+            errors++;
+        }
+    }
+    return errors;
+}
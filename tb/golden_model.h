@@ -0,0 +1,41 @@
+/***********************************************************************
+ * golden_model.h
+ * Golden (reference) model of the computations of the IP (myip). It is
+ * plain C++, without SystemC, so it can be used on the testbench to
+ * check the outputs of the IP (see golden_checker.h) and on the host
+ * over whole datasets (see golden/golden_bench.cpp).
+ *
+ * The computations are vectorised with AVX2 or SSSE3 when the host
+ * supports them (checked at run time), with a scalar fallback.
+ * Keep it in step with myip::write_cthread (synth/ip.cpp).
+ */
+
+#ifndef GOLDEN_MODEL_H_
+#define GOLDEN_MODEL_H_
+
+#include "../sw/app.h"
+
+// Implementations of the golden model:
+enum golden_isa {
+    GOLDEN_AUTO, // The fastest one supported by the host
+    GOLDEN_SCALAR,
+    GOLDEN_SSSE3,
+    GOLDEN_AVX2
+};
+
+// Select the implementation used by golden_compute (GOLDEN_AUTO by default).
+// It returns the selected one, which is GOLDEN_SCALAR if the host does not support the requested one:
+golden_isa golden_select(golden_isa isa);
+const char *golden_isa_name(golden_isa isa);
+
+// Compute the output of the IP (IPOUT_SIZE bytes) for an input (IPIN_SIZE bytes):
+void golden_compute(const char *inbuff, char *outbuff);
+
+// Compute 'n' inputs stored one after the other (e.g. a whole dataset):
+void golden_compute_batch(const char *inputs, char *outputs, unsigned n);
+
+// Compare an output of the IP with the golden one. It returns the number of
+// different bytes and the index of the first one in 'first' (if not NULL):
+unsigned golden_compare(const char *outbuff, const char *golden, int *first);
+
+#endif
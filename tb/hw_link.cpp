@@ -0,0 +1,55 @@
+/***********************************************************************
+ * hw_link.cpp
+ * Link between sctop and the hardware simulator (hwsim) in the
+ * partitioned simulation. See hw_link.h.
+ */
+
+#include "hw_link.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static const uint32_t HW_LINK_MAGIC = 0x48574c4b; // "HWLK"
+
+static HWLinkShared *map_file(const char *file_name, bool create) {
+    int fd = open(file_name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd < 0)
+        return NULL;
+    if (create && ftruncate(fd, sizeof(HWLinkShared)) != 0) {
+        ::close(fd);
+        return NULL;
+    }
+    void *p = mmap(NULL, sizeof(HWLinkShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping remains valid
+    return p == MAP_FAILED ? NULL : (HWLinkShared*) p;
+}
+
+bool HWLink::create(const char *file_name) {
+    close();
+    shared = map_file(file_name, true);
+    if (!shared)
+        return false;
+    memset(shared, 0, sizeof(HWLinkShared));
+    shared->magic = HW_LINK_MAGIC;
+    return true;
+}
+
+bool HWLink::attach(const char *file_name) {
+    close();
+    shared = map_file(file_name, false);
+    if (shared && shared->magic != HW_LINK_MAGIC)
+        close();
+    return shared != NULL;
+}
+
+void HWLink::close() {
+    if (shared)
+        munmap(shared, sizeof(HWLinkShared));
+    shared = NULL;
+}
+
+void HWLink::relax() {
+    sched_yield();
+}
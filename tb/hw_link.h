@@ -0,0 +1,103 @@
+/***********************************************************************
+ * hw_link.h
+ * Link between sctop and the hardware simulator (hwsim, see
+ * hwsim/hwsim.cpp) in the partitioned simulation. The two processes
+ * map the same file, which holds:
+ *  - two lock-free single producer single consumer rings: the AXI
+ *    transactions from sctop to hwsim and their responses back,
+ *  - the local time of every simulator, for the conservative time
+ *    synchronization: hwsim never runs more than a quantum ahead of
+ *    the time published by sctop (except to serve a transaction, while
+ *    sctop is waiting for it), and sctop never runs more than a quantum
+ *    ahead of hwsim,
+ *  - the level of the interrupt request of the IP.
+ * Times are in picoseconds. The 64 bit members are written by a single
+ * process, so a 64 bit host is expected.
+ */
+
+#ifndef HW_LINK_H_
+#define HW_LINK_H_
+
+#include <inttypes.h>
+#include <systemc.h>
+
+struct HWRequest {
+    enum { READ, WRITE, RESET };
+    uint32_t command;
+    uint32_t address; // Offset to SYS_AXI_BASE
+    uint32_t data; // Data to write
+    uint32_t length; // Bytes to write or read (1, 2 or 4)
+    uint64_t time; // Time of the request (sctop)
+};
+
+struct HWResponse {
+    uint32_t data; // Data read
+    uint32_t irq; // Level of the interrupt request when the transaction is done
+    uint64_t time; // Time when the transaction is done (hwsim)
+};
+
+template<class T, unsigned N>
+struct HWRing {
+    volatile uint32_t head; // Next item to write (only written by the producer)
+    volatile uint32_t tail; // Next item to read (only written by the consumer)
+    T items[N];
+
+    bool push(const T &item) {
+        uint32_t h = head;
+        if (h - tail == N)
+            return false;
+        items[h % N] = item;
+        __sync_synchronize(); // The item is written before it is published
+        head = h + 1;
+        return true;
+    }
+    bool pop(T &item) {
+        uint32_t t = tail;
+        if (head == t)
+            return false;
+        __sync_synchronize(); // The item is read after it has been published
+        item = items[t % N];
+        __sync_synchronize();
+        tail = t + 1;
+        return true;
+    }
+};
+
+struct HWLinkShared {
+    uint32_t magic;
+    uint64_t clock_cycle; // Period of the clock of the AXI bus
+    uint64_t quantum; // Maximum time difference between the simulators
+    volatile uint64_t iss_time; // Time reached by sctop
+    volatile uint64_t hw_time; // Time reached by hwsim
+    volatile uint32_t irq; // Level of the interrupt request of the IP
+    volatile uint32_t hw_ready; // hwsim is running
+    volatile uint32_t quit; // sctop has finished
+    HWRing<HWRequest, 64> requests;
+    HWRing<HWResponse, 64> responses;
+};
+
+class HWLink {
+public:
+    HWLink() : shared(NULL) {}
+    ~HWLink() { close(); }
+
+    // Create the link file (sctop):
+    bool create(const char *file_name);
+    // Map the link file created by sctop (hwsim):
+    bool attach(const char *file_name);
+    void close();
+
+    bool is_open() const { return shared != NULL; }
+    HWLinkShared *operator->() { return shared; }
+
+    // Give the host core to the other process while spinning:
+    static void relax();
+
+    static uint64_t to_ps(const sc_time &t) { return (uint64_t) (t / sc_time(1, SC_PS)); }
+    static sc_time from_ps(uint64_t ps) { return sc_time((double) ps, SC_PS); }
+
+private:
+    HWLinkShared *shared;
+};
+
+#endif
@@ -0,0 +1,208 @@
+/***********************************************************************
+ * hw_partition.cpp
+ * Partitioned simulation: the cycle level AXI subsystem runs in a
+ * separate process. See hw_partition.h.
+ */
+
+#include "hw_partition.h"
+#include "sim_stats.h"
+#include <cstdio>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace sc_core;
+
+// Wall clock seconds that sctop waits for hwsim to start:
+static const double HWSIM_START_TIMEOUT = 10;
+
+HWPartition::HWPartition(sc_module_name name, const sc_time &clock_cycle) :
+        Module(name), resetn("RESETN"), enabled(false), hwsim_pid(0), clock_cycle(clock_cycle) {
+    rw_socket.register_b_transport(this, &HWPartition::b_transport);
+
+    SC_THREAD(sync);
+
+    SC_METHOD(reset);
+    sensitive << resetn.neg();
+    dont_initialize();
+}
+
+HWPartition::~HWPartition() {
+    stop();
+}
+
+bool HWPartition::start(const char *program, const char *file_name, const sc_time &q) {
+    if (!link.create(file_name)) {
+        std::cerr << "Cannot create the link file " << file_name << std::endl;
+        return false;
+    }
+    link_file = file_name;
+    quantum = q;
+    link->clock_cycle = HWLink::to_ps(clock_cycle);
+    link->quantum = HWLink::to_ps(quantum);
+
+    hwsim_pid = fork();
+    if (hwsim_pid == 0) {
+        execl(program, program, file_name, (char*) NULL);
+        perror(program);
+        _exit(1);
+    }
+    if (hwsim_pid < 0) {
+        hwsim_pid = 0;
+        link.close();
+        return false;
+    }
+
+    double limit = SimStats::wall_time() + HWSIM_START_TIMEOUT;
+    while (!link->hw_ready) {
+        bool finished = waitpid(hwsim_pid, NULL, WNOHANG) == hwsim_pid;
+        if (finished || SimStats::wall_time() > limit) {
+            std::cerr << "The hardware simulator " << program << " did not start" << std::endl;
+            if (finished)
+                hwsim_pid = 0; // Already reaped
+            else
+                kill(hwsim_pid, SIGKILL); // It does not read the link yet, so it is killed (and reaped by stop())
+            stop();
+            return false;
+        }
+        HWLink::relax();
+    }
+    enabled = true;
+    return true;
+}
+
+void HWPartition::stop() {
+    if (link.is_open()) {
+        link->quit = 1;
+        __sync_synchronize();
+        if (hwsim_pid > 0)
+            waitpid(hwsim_pid, NULL, 0);
+        link.close();
+        unlink(link_file.c_str());
+    }
+    hwsim_pid = 0;
+    enabled = false;
+}
+
+void HWPartition::split_burst(tlm::tlm_generic_payload &payload, sc_time &delay_time) {
+    unsigned length = payload.get_data_length();
+    if (length % 4) {
+        payload.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+        return;
+    }
+    tlm::tlm_generic_payload word;
+    word.set_command(payload.get_command());
+    word.set_data_length(4);
+    word.set_streaming_width(4);
+    word.set_byte_enable_ptr(NULL);
+    for (unsigned i = 0; i < length; i += 4) {
+        word.set_address(payload.get_address() + i);
+        word.set_data_ptr(payload.get_data_ptr() + i);
+        word.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        transaction(word, delay_time);
+        if (word.get_response_status() != tlm::TLM_OK_RESPONSE) {
+            payload.set_response_status(word.get_response_status());
+            return;
+        }
+    }
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void HWPartition::b_transport(tlm::tlm_generic_payload &payload, sc_time &delay_time) {
+    if (!enabled) {
+        local_socket->b_transport(payload, delay_time);
+        return;
+    }
+
+    // The processor and the DMA controller may access the AXI bus at the same time,
+    // so the transactions are sent to hwsim one after the other:
+    bus_mutex.lock();
+    if (payload.get_byte_enable_ptr())
+        payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+    else if (payload.get_data_length() > 4)
+        split_burst(payload, delay_time); // hwsim serves one AXI4-Lite transaction per request
+    else
+        transaction(payload, delay_time);
+    bus_mutex.unlock();
+}
+
+void HWPartition::transaction(tlm::tlm_generic_payload &payload, sc_time &delay_time) {
+    HWRequest request;
+    request.address = (uint32_t) payload.get_address();
+    request.length = payload.get_data_length();
+    if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        request.command = HWRequest::WRITE;
+        request.data = request.length == 1 ? *(uint8_t*) payload.get_data_ptr() :
+                request.length == 2 ? *(uint16_t*) payload.get_data_ptr() : *(uint32_t*) payload.get_data_ptr();
+    } else {
+        request.command = HWRequest::READ;
+        request.data = 0;
+    }
+    // The local time of the initiator (e.g. the quantum of the ISS) is taken into account:
+    request.time = HWLink::to_ps(sc_time_stamp() + delay_time);
+
+    // sctop cannot advance until the response, so hwsim may run ahead to serve it:
+    link->iss_time = request.time;
+    while (!link->requests.push(request))
+        HWLink::relax();
+    HWResponse response;
+    while (!link->responses.pop(response)) {
+        if (waitpid(hwsim_pid, NULL, WNOHANG) == hwsim_pid) {
+            std::cerr << "The hardware simulator has finished unexpectedly" << std::endl;
+            hwsim_pid = 0;
+            stop();
+            payload.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
+            sc_stop();
+            return;
+        }
+        HWLink::relax();
+    }
+
+    // Only the bytes of the payload are written (e.g. a byte element of the DMA controller):
+    if (request.command == HWRequest::READ) {
+        if (request.length == 1)
+            *(uint8_t*) payload.get_data_ptr() = (uint8_t) response.data;
+        else if (request.length == 2)
+            *(uint16_t*) payload.get_data_ptr() = (uint16_t) response.data;
+        else
+            *(uint32_t*) payload.get_data_ptr() = response.data;
+    }
+    it_signal = response.irq != 0;
+
+    // The delay is consumed by the wait until the end of the transaction:
+    sc_time done = HWLink::from_ps(response.time);
+    if (done > sc_time_stamp())
+        wait(done - sc_time_stamp());
+    delay_time = SC_ZERO_TIME;
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void HWPartition::sync() {
+    // hwsim is started during the elaboration:
+    if (!enabled)
+        return;
+    while (true) {
+        wait(quantum == SC_ZERO_TIME ? clock_cycle : quantum);
+        if (!enabled)
+            return;
+        SIM_STATS_ACTIVATION();
+        // Publish the time of sctop and wait until hwsim is less than a quantum behind:
+        uint64_t now = HWLink::to_ps(sc_time_stamp());
+        link->iss_time = now;
+        while (link->hw_time + link->quantum < now && !link->quit)
+            HWLink::relax();
+        it_signal = link->irq != 0;
+    }
+}
+
+void HWPartition::reset() {
+    if (!enabled)
+        return;
+    HWRequest request;
+    request.command = HWRequest::RESET;
+    request.address = request.data = request.length = 0;
+    request.time = HWLink::to_ps(sc_time_stamp());
+    while (!link->requests.push(request))
+        HWLink::relax();
+}
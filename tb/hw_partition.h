@@ -0,0 +1,65 @@
+/***********************************************************************
+ * hw_partition.h
+ * Partitioned simulation: the cycle level AXI subsystem (AXI master and
+ * AXISlave with the IP) runs in a separate process, the hardware
+ * simulator hwsim (see hwsim/hwsim.cpp), with its own SystemC kernel,
+ * so the ISS and the hardware models are simulated on two host cores.
+ *
+ * This module sits between the AXISwitch and the AXIBridge. When the
+ * partitioned simulation is disabled, it forwards the transactions to
+ * the AXIBridge. Otherwise it starts hwsim, sends every transaction to
+ * it through the link (see hw_link.h) and waits for the response, and
+ * drives the interrupt request of the IP from the level published by
+ * hwsim. Both simulators are kept within a quantum of each other, so
+ * the interrupt request may be seen up to a quantum late.
+ */
+
+#ifndef HW_PARTITION_H_
+#define HW_PARTITION_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <libsimsoc/interfaces/tlm_signal.hpp>
+#include <libsimsoc/module.hpp>
+#include "irq_wakeup.h"
+#include <sys/types.h>
+#include "hw_link.h"
+
+class HWPartition: public simsoc::Module {
+public:
+    typedef HWPartition SC_CURRENT_USER_MODULE;
+    HWPartition(sc_core::sc_module_name name, const sc_core::sc_time &clock_cycle);
+    ~HWPartition();
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    // Start the hardware simulator 'program' (before the simulation starts):
+    bool start(const char *program, const char *link_file, const sc_core::sc_time &quantum);
+    // Tell the hardware simulator to finish and wait for it:
+    void stop();
+    bool is_enabled() const { return enabled; }
+
+    sc_core::sc_in<bool> resetn;
+    IrqSignalPort it_signal;
+
+    tlm_utils::simple_target_socket<HWPartition> rw_socket; // From the AXISwitch
+    tlm_utils::simple_initiator_socket<HWPartition> local_socket; // To the AXIBridge
+
+protected:
+    void sync(); // Thread of the time synchronization with hwsim
+    void reset(); // Method triggered by the reset signal
+    void transaction(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time); // One request to hwsim
+    void split_burst(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time); // One request per word
+
+    bool enabled;
+    HWLink link;
+    std::string link_file;
+    pid_t hwsim_pid;
+    sc_core::sc_mutex bus_mutex; // One transaction at a time
+    sc_core::sc_time clock_cycle;
+    sc_core::sc_time quantum;
+};
+
+#endif
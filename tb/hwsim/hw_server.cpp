@@ -0,0 +1,54 @@
+/***********************************************************************
+ * hw_server.cpp
+ * SystemC module of the hardware simulator (hwsim) of the partitioned
+ * simulation. See hw_server.h.
+ */
+
+#include "hw_server.h"
+#include "../sim_stats.h"
+#include "../../sw/mmap.h"
+#include <unistd.h>
+
+HWServer::HWServer(sc_module_name name, HWLink &link, const sc_time &clock_cycle) :
+        AXIDriver(name, clock_cycle), link(link) {
+    SC_THREAD(serve);
+}
+
+void HWServer::serve() {
+    go.write(false);
+    reset();
+    link->hw_ready = 1;
+
+    while (true) {
+        uint64_t now = HWLink::to_ps(sc_time_stamp());
+        link->hw_time = now;
+        link->irq = interrupt_request.read();
+
+        HWRequest request;
+        if (link->requests.pop(request)) {
+            SIM_STATS_ACTIVATION();
+            // The request is done at the time of sctop, or as soon as possible if hwsim is ahead:
+            if (request.time > now)
+                wait(HWLink::from_ps(request.time - now));
+            if (request.command == HWRequest::RESET) {
+                reset();
+                continue;
+            }
+            HWResponse response;
+            response.data = transaction(request.command == HWRequest::READ, request.address + SYS_AXI_BASE,
+                    request.data, request.length);
+            response.irq = interrupt_request.read();
+            response.time = HWLink::to_ps(sc_time_stamp());
+            while (!link->responses.push(response))
+                HWLink::relax();
+        } else if (link->quit || getppid() == 1) {
+            // sctop has finished (or it has been killed):
+            sc_stop();
+            return;
+        } else if (now < link->iss_time + link->quantum) {
+            wait(clk_cycle);
+        } else {
+            HWLink::relax();
+        }
+    }
+}
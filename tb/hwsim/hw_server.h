@@ -0,0 +1,29 @@
+/***********************************************************************
+ * hw_server.h
+ * SystemC module of the hardware simulator (hwsim) of the partitioned
+ * simulation. It takes the AXI transactions sent by sctop through the
+ * link (see ../hw_link.h) and runs them on the AXI master, like the
+ * AXIBridge does in sctop (see axi_driver.h). It also generates the reset signal of the
+ * AXI subsystem and keeps the time of hwsim within a quantum of the
+ * time of sctop.
+ */
+
+#ifndef HW_SERVER_H_
+#define HW_SERVER_H_
+
+#include <systemc.h>
+#include "../hw_link.h"
+#include "axi_driver.h"
+
+class HWServer: public AXIDriver {
+public:
+    typedef HWServer SC_CURRENT_USER_MODULE;
+    HWServer(sc_module_name name, HWLink &link, const sc_time &clock_cycle);
+
+private:
+    void serve();
+
+    HWLink &link;
+};
+
+#endif
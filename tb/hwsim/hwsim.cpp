@@ -0,0 +1,66 @@
+/***********************************************************************
+ * hwsim.cpp
+ * Hardware simulator of the partitioned simulation (sctop -partition,
+ * see ../hw_partition.h). It simulates the cycle level AXI subsystem
+ * (AXI master and AXISlave with the IP) with its own SystemC kernel,
+ * in a separate process, so it runs on another host core than the ISS.
+ * It is started by sctop with the name of the link file (see
+ * ../hw_link.h) as its only argument, and it finishes with sctop.
+ *
+ * Build it with 'make hwsim' in the 'tb' directory.
+ */
+
+#include <systemc.h>
+#include <iostream>
+#include "../hw_link.h"
+#include "../sim_stats.h"
+#include "AXIBridgeStructs.h"
+#include "axi_bindings.h"
+#include "axi_lite_master_transaction_model.h"
+#include "hw_server.h"
+#include "../../synth/AXISlave.h"
+
+int sc_main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <link file>" << std::endl;
+        std::cerr << "It is started by sctop -partition" << std::endl;
+        return 1;
+    }
+
+    HWLink link;
+    if (!link.attach(argv[1])) {
+        std::cerr << argv[0] << ": cannot open the link file " << argv[1] << std::endl;
+        return 1;
+    }
+
+    sc_time clock_cycle = HWLink::from_ps(link->clock_cycle);
+    sc_clock clk("CLK", clock_cycle);
+    sc_signal<bool> resetn("RESETN");
+    AXI_Signals axiSignals;
+
+    HWServer server("HW_SERVER", link, clock_cycle);
+    axi_lite_master_transaction_model axi_master("axi_master");
+    AXISlave axi_slave("axi_slave");
+
+    server.clk(clk);
+    server.resetn(resetn);
+    bind_axi_driver(server, axiSignals);
+
+    // Same connections as in the SubSystem of sctop (see axi_bindings.h):
+    axi_master.m_axi_lite_aclk(clk);
+    axi_master.m_axi_lite_aresetn(resetn);
+    bind_axi_master(axi_master, axiSignals);
+
+    axi_slave.axi_aclk(clk);
+    axi_slave.axi_aresetn(resetn);
+    bind_axi_slave(axi_slave, axiSignals);
+
+    double wall = SimStats::wall_time();
+    sc_start();
+    wall = SimStats::wall_time() - wall;
+
+    std::cerr << "hwsim: " << server.get_transactions() << " AXI transactions, "
+            << (uint64_t) (sc_time_stamp() / clock_cycle) << " cycles, "
+            << wall << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,61 @@
+/***********************************************************************
+ * idle_gate.cpp
+ * SystemC module that generates a gated copy of the clock for the AXI
+ * bus and the IP. See idle_gate.h.
+ */
+
+#include "idle_gate.h"
+#include "sim_stats.h"
+
+// Idle clock cycles before the clock is stopped (to let the AXI channel FSMs return to their idle states):
+#define IDLE_HOLD_CYCLES 8
+
+IdleClockGate::IdleClockGate(sc_module_name name, const sc_time &clock_cycle) :
+        gclk("GCLK"), resetn("RESETN"), enabled(false), clk_cycle(clock_cycle), skipped(0), stops(0) {
+    SC_THREAD(run);
+}
+
+bool IdleClockGate::idle() const {
+    return resetn.read() && !go.read() && !busy.read() && !done.read() &&
+            !arvalid.read() && !rvalid.read() && !awvalid.read() && !wvalid.read() && !bvalid.read() &&
+            !ip_busy.read();
+}
+
+void IdleClockGate::run() {
+    if (!enabled)
+        return;
+
+    // Same waveform as the sc_clock: rising edges at every multiple of the period, starting at 0:
+    sc_time half = clk_cycle / 2;
+    unsigned idle_cycles = 0;
+    while (true) {
+        if (idle_cycles >= IDLE_HOLD_CYCLES) {
+            // Stop the clock until the AXI bridge starts a transaction or the reset is asserted:
+            ++stops;
+            sc_time stop_time = sc_time_stamp();
+            wait(go.value_changed_event() | resetn.value_changed_event());
+            SIM_STATS_ACTIVATION();
+            // Restart on the next rising edge of the free running clock (after the one of the current time, if any):
+            uint64_t edges = (uint64_t) (sc_time_stamp() / clk_cycle) + 1;
+            sc_time restart = edges * clk_cycle;
+            wait(restart - sc_time_stamp());
+            skipped += (uint64_t) ((restart - stop_time) / clk_cycle);
+            idle_cycles = 0;
+        }
+        gclk.write(true);
+        wait(half);
+        gclk.write(false);
+        wait(clk_cycle - half);
+        idle_cycles = idle() ? idle_cycles + 1 : 0;
+    }
+}
+
+void IdleClockGate::report() {
+    if (!enabled)
+        return;
+    uint64_t cycles = (uint64_t) (sc_time_stamp() / clk_cycle);
+    std::cout << " IDLE SKIP: " << skipped << " of " << cycles << " clock cycles of the AXI bus and IP skipped";
+    if (cycles)
+        std::cout << " (" << (100.0 * skipped / cycles) << "%)";
+    std::cout << ", clock stopped " << stops << " times" << std::endl;
+}
@@ -0,0 +1,62 @@
+/***********************************************************************
+ * idle_gate.h
+ * SystemC module that generates a gated copy of the clock for the cycle
+ * level AXI master and AXISlave (with the IP). The clock is stopped
+ * when the AXI bus has been idle for a few cycles (no transaction from
+ * the AXI bridge, no VALID asserted and the reset released), and it is
+ * restarted on the next clock edge after the AXI bridge starts a
+ * transaction (or the reset is asserted). While it is stopped, none of
+ * the clocked processes of the AXI bus and the IP is evaluated, so the
+ * simulation jumps over the cycles where the software runs without
+ * accessing the IP (e.g. waiting for its interrupt request).
+ *
+ * The computations of the single job mode of myip are done within the
+ * write transaction that starts them, and the clock is kept running
+ * while the jobs of its submission ring are pending (ip_busy). The
+ * restarted clock is aligned with the free running clock, so the cycle
+ * timing of the transactions does not change.
+ */
+
+#ifndef IDLE_GATE_H_
+#define IDLE_GATE_H_
+
+#include <systemc.h>
+#include <inttypes.h>
+
+SC_MODULE(IdleClockGate) {
+public:
+    sc_out<bool> gclk; // Gated clock
+    sc_in<bool> resetn;
+    // AXI bridge to AXI master:
+    sc_in<bool> go;
+    sc_in<bool> busy;
+    sc_in<bool> done;
+    // VALID signals of the AXI4-Lite channels:
+    sc_in<bool> arvalid;
+    sc_in<bool> rvalid;
+    sc_in<bool> awvalid;
+    sc_in<bool> wvalid;
+    sc_in<bool> bvalid;
+    // The IP has work to do without AXI transactions (jobs of the submission ring):
+    sc_in<bool> ip_busy;
+
+    typedef IdleClockGate SC_CURRENT_USER_MODULE;
+    IdleClockGate(sc_module_name name, const sc_time &clock_cycle);
+
+    // Enable the gating of the clock (before the simulation starts):
+    void enable(bool e) { enabled = e; }
+    bool is_enabled() const { return enabled; }
+    // Print the number of skipped clock cycles:
+    void report();
+
+private:
+    void run(); // Thread that generates the gated clock
+    bool idle() const;
+
+    bool enabled;
+    sc_time clk_cycle;
+    uint64_t skipped; // Clock cycles skipped
+    uint64_t stops; // Number of times the clock has been stopped
+};
+
+#endif
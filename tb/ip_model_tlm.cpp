@@ -0,0 +1,201 @@
+/***********************************************************************
+ * ip_model_tlm.cpp
+ * Untimed TLM model of the IP (myip) connected to the AXI bus. See
+ * ip_model_tlm.h.
+ */
+
+#include "ip_model_tlm.h"
+#include "golden_model.h"
+#include "sim_stats.h"
+
+using namespace std;
+using namespace sc_core;
+
+IPModelTLM::IPModelTLM(sc_module_name name, const sc_time &latency) :
+        Module(name), resetn("RESETN"), single_irq(false), irq(false), latency(latency) {
+    rw_socket.register_b_transport(this, &IPModelTLM::b_transport);
+
+    inbuff = new char[IPIN_SIZE * IP_SLOTS];
+    outbuff = new char[IPOUT_SIZE * IP_SLOTS];
+    clear();
+
+    SC_THREAD(updateirq);
+
+    SC_METHOD(reset);
+    sensitive << resetn.neg();
+    dont_initialize();
+}
+
+IPModelTLM::~IPModelTLM() {
+    delete [] inbuff;
+    delete [] outbuff;
+}
+
+void IPModelTLM::update_irq(const sc_time &delay) {
+    bool level = single_irq || ring_irq_level();
+    if (level == irq)
+        return;
+    irq = level;
+    // A released request is propagated at once:
+    if (!irq)
+        irq_event.cancel();
+    irq_event.notify(irq ? delay : SC_ZERO_TIME);
+}
+
+void IPModelTLM::write(uint32_t address, uint32_t data) {
+    // Same address decoding as myip::write_cthread:
+    if (address < NREGISTERS * 4) {
+        unsigned index = address >> 2;
+        // The indices updated by the IP are read only:
+        if (index != IP_REG_SQ_HEAD && index != IP_REG_CQ_TAIL)
+            registers[index] = data;
+        if (index == IP_REG_CTRL) {
+            if ((data & 0x80) == 0x80) {
+                // Run the "computations" and request the interrupt after the latency:
+                golden_compute(inbuff, outbuff);
+                single_irq = true;
+                irq = false;
+                update_irq(latency);
+            } else {
+                // Disable the interrupt request when whatever other value is written in register 0:
+                single_irq = false;
+                update_irq(SC_ZERO_TIME);
+            }
+        } else if (index == IP_REG_SQ_TAIL)
+            run_jobs();
+        else
+            update_irq(SC_ZERO_TIME); // Reaped completions or new coalescing
+    } else if (address >= IP_SQ_OFFSET && address < IP_SQ_OFFSET + IP_RING_SIZE * 4) {
+        sq[(address - IP_SQ_OFFSET) >> 2] = data;
+    } else if (address >= IPIN_OFFSET && address < IPOUT_OFFSET) {
+        uint32_t index = (address - IPIN_OFFSET) >> 2;
+        if (index < IPIN_SIZE * IP_SLOTS)
+            inbuff[index] = (char) data;
+    }
+}
+
+void IPModelTLM::run_jobs() {
+    unsigned jobs = 0;
+    while (registers[IP_REG_SQ_HEAD] != registers[IP_REG_SQ_TAIL]) {
+        unsigned job = sq[registers[IP_REG_SQ_HEAD] % IP_RING_SIZE];
+        unsigned in = IP_JOB_IN(job);
+        unsigned out = IP_JOB_OUT(job);
+        if (in < IP_SLOTS && out < IP_SLOTS) {
+            golden_compute(inbuff + in * IPIN_SIZE, outbuff + out * IPOUT_SIZE);
+            job |= IP_JOB_DONE << 16;
+        } else
+            job |= IP_JOB_ERROR << 16;
+        cq[registers[IP_REG_CQ_TAIL] % IP_RING_SIZE] = job;
+        registers[IP_REG_CQ_TAIL]++;
+        registers[IP_REG_SQ_HEAD]++;
+        jobs++;
+    }
+    // The completions are written at once, the interrupt comes after the latency of the batch:
+    update_irq(jobs * latency);
+}
+
+bool IPModelTLM::ring_irq_level() const {
+    unsigned pending = registers[IP_REG_CQ_TAIL] - registers[IP_REG_CQ_HEAD];
+    if (pending == 0)
+        return false;
+    if (registers[IP_REG_SQ_HEAD] == registers[IP_REG_SQ_TAIL])
+        return true;
+    if (registers[IP_REG_COALESCE] && pending >= registers[IP_REG_COALESCE])
+        return true;
+    for (unsigned i = 0; i < pending && i < IP_RING_SIZE; i++)
+        if (IP_JOB_FLAGS(cq[(registers[IP_REG_CQ_HEAD] + i) % IP_RING_SIZE]) & IP_JOB_IRQ)
+            return true;
+    return false;
+}
+
+uint32_t IPModelTLM::read(uint32_t address) {
+    // Same address decoding as myip::read_cthread:
+    if (address < NREGISTERS * 4)
+        return registers[address >> 2];
+    if (address >= IP_CQ_OFFSET && address < IP_CQ_OFFSET + IP_RING_SIZE * 4)
+        return cq[(address - IP_CQ_OFFSET) >> 2];
+    if (address >= IPOUT_OFFSET && address < IPOUT_OFFSET + IPOUT_SIZE * IP_SLOTS * 4)
+        return (uint32_t) (int) outbuff[(address - IPOUT_OFFSET) >> 2]; // Sign extended, like the sc_uint assignment of myip
+    return 0;
+}
+
+void IPModelTLM::b_transport(tlm::tlm_generic_payload &payload, sc_time &delay_time) {
+    // Like the AXI bridge, one initiator at a time (the processor or the DMA controller):
+    bus_mutex.lock();
+    transaction(payload);
+    bus_mutex.unlock();
+}
+
+void IPModelTLM::transaction(tlm::tlm_generic_payload &payload) {
+    if (payload.get_byte_enable_ptr()) {
+        payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    uint32_t address = payload.get_address();
+    unsigned char *data = payload.get_data_ptr();
+
+    // Byte, half-word and word accesses, and bursts of words, like the AXI bridge:
+    unsigned length = payload.get_data_length();
+    if (length > 4 && length % 4) {
+        payload.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+        return;
+    }
+    if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        if (length == 1) {
+            ++SimStats::axi_writes;
+            write(address, *(uint8_t*) data);
+        } else if (length == 2) {
+            ++SimStats::axi_writes;
+            write(address, *(uint16_t*) data);
+        } else
+            for (unsigned i = 0; i < length; i += 4) {
+                ++SimStats::axi_writes;
+                write(address + i, *(uint32_t*) (data + i));
+            }
+    } else if (payload.get_command() == tlm::TLM_READ_COMMAND) {
+        if (length == 1) {
+            ++SimStats::axi_reads;
+            *(uint8_t*) data = read(address);
+        } else if (length == 2) {
+            ++SimStats::axi_reads;
+            *(uint16_t*) data = read(address);
+        } else
+            for (unsigned i = 0; i < length; i += 4) {
+                ++SimStats::axi_reads;
+                *(uint32_t*) (data + i) = read(address + i);
+            }
+    }
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void IPModelTLM::updateirq() {
+    bool last_irq = false;
+    while (true) {
+        wait(irq_event);
+        if (irq && !last_irq)
+            ++SimStats::irqs;
+        last_irq = irq;
+        it_signal = irq;
+    }
+}
+
+void IPModelTLM::clear() {
+    for (unsigned i = 0; i < NREGISTERS; i++)
+        registers[i] = 0;
+    for (unsigned i = 0; i < IP_RING_SIZE; i++)
+        sq[i] = cq[i] = 0;
+    for (unsigned i = 0; i < IPIN_SIZE * IP_SLOTS; i++)
+        inbuff[i] = 0;
+    for (unsigned i = 0; i < IPOUT_SIZE * IP_SLOTS; i++)
+        outbuff[i] = 0;
+}
+
+void IPModelTLM::reset() {
+    // Nothing of the jobs of the previous run remains (e.g. between the runs of the multi-run mode):
+    clear();
+    single_irq = false;
+    irq = false;
+    irq_event.cancel();
+    irq_event.notify(SC_ZERO_TIME);
+}
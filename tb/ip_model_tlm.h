@@ -0,0 +1,69 @@
+/***********************************************************************
+ * ip_model_tlm.h
+ * Untimed TLM model of the IP (myip) connected to the AXI bus. It has
+ * the same register and buffer map as myip (see synth/ip.h and
+ * sw/app.h), but it is a TLM target: the accesses take no time, the
+ * "computations" are done instantly with the golden model (see
+ * golden_model.h) and the interrupt request is raised after an
+ * annotated latency (per job, for the jobs of the submission ring).
+ *
+ * It is used instead of the cycle level AXI bus and IP when sctop is
+ * run with -untimed (see AXISwitch), so the firmware can be developed
+ * with a fast turnaround.
+ */
+
+#ifndef IP_MODEL_TLM_H_
+#define IP_MODEL_TLM_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <libsimsoc/interfaces/tlm_signal.hpp>
+#include <libsimsoc/module.hpp>
+#include "irq_wakeup.h"
+#include "../sw/app.h"
+
+class IPModelTLM: public simsoc::Module {
+public:
+    typedef IPModelTLM SC_CURRENT_USER_MODULE;
+    // latency: time from the start of the computations to the interrupt request
+    IPModelTLM(sc_core::sc_module_name name, const sc_core::sc_time &latency);
+    ~IPModelTLM();
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    void set_latency(const sc_core::sc_time &l) { latency = l; }
+
+    sc_core::sc_in<bool> resetn;
+    IrqSignalPort it_signal;
+
+    tlm_utils::simple_target_socket<IPModelTLM> rw_socket;
+
+    /* State of the IP. It has the same layout as in myip: */
+    static const unsigned NREGISTERS = 16;
+    unsigned registers[NREGISTERS];
+    unsigned sq[IP_RING_SIZE]; // Submission ring
+    unsigned cq[IP_RING_SIZE]; // Completion ring
+    char *inbuff; // input buffers (IP_SLOTS)
+    char *outbuff; // output buffers (IP_SLOTS)
+    bool single_irq; // Interrupt request of the single job mode
+    bool irq; // Level of the interrupt request
+
+protected:
+    void transaction(tlm::tlm_generic_payload &payload); // Served by b_transport, with bus_mutex held
+    void write(uint32_t address, uint32_t data);
+    uint32_t read(uint32_t address);
+    void run_jobs(); // Jobs of the submission ring, up to the doorbell
+    bool ring_irq_level() const; // Same coalescing as myip::ring_irq_level
+    void update_irq(const sc_core::sc_time &delay);
+
+    void updateirq(); // Thread that drives it_signal
+    void reset(); // Method triggered by the reset signal
+    void clear(); // Clear the registers, the rings and the buffers
+
+    sc_core::sc_time latency;
+    sc_core::sc_event irq_event;
+    sc_core::sc_mutex bus_mutex; // One transaction at a time
+};
+
+#endif
@@ -0,0 +1,61 @@
+/***********************************************************************
+ * irq_wakeup.h
+ * Wake-up of the sleeping processor (see the SLEEP register of
+ * sw/sysctrl.h). The ISS has no wait-for-interrupt state, so the
+ * software sleeps by writing SYSCTRL_SLEEP, and the SysCtrl module
+ * blocks the ISS thread until one of the interrupt lines of irqc is
+ * raised. Meanwhile the processor is not stepped at all: the simulated
+ * time jumps to the interrupt, which is then taken as usual.
+ *
+ * IrqWakeup keeps the levels of the interrupt lines. The interrupt
+ * sources drive their line with an IrqSignalPort, which is a
+ * SignalInitiatorPort that also reports the level to the IrqWakeup.
+ */
+
+#ifndef IRQ_WAKEUP_H_
+#define IRQ_WAKEUP_H_
+
+#include <systemc>
+#include <libsimsoc/interfaces/tlm_signal.hpp>
+#include <inttypes.h>
+
+class IrqWakeup {
+public:
+    IrqWakeup(): levels(0) {}
+
+    void set(unsigned line, bool level) {
+        uint32_t mask = 1u << line;
+        if (level && !(levels & mask))
+            raised.notify(sc_core::SC_ZERO_TIME);
+        levels = level ? (levels | mask) : (levels & ~mask);
+    }
+
+    // An interrupt line is high (the processor must not go to sleep):
+    bool pending() const { return levels != 0; }
+    // Notified when an interrupt line rises:
+    const sc_core::sc_event &event() const { return raised; }
+
+protected:
+    uint32_t levels; // One bit per interrupt line
+    sc_core::sc_event raised;
+};
+
+class IrqSignalPort: public simsoc::SignalInitiatorPort<bool> {
+public:
+    IrqSignalPort(): wakeup(NULL), line(0) {}
+
+    void set_wakeup(IrqWakeup *w, unsigned l) { wakeup = w; line = l; }
+
+    IrqSignalPort &operator=(bool level) {
+        simsoc::SignalInitiatorPort<bool>::operator=(level);
+        if (wakeup)
+            wakeup->set(line, level);
+        return *this;
+    }
+
+protected:
+    IrqWakeup *wakeup;
+    unsigned line; // Input of irqc
+};
+
+#endif
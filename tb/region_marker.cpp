@@ -0,0 +1,122 @@
+/***********************************************************************
+ * region_marker.cpp
+ * SystemC module of the region markers of the simulation. See
+ * region_marker.h.
+ */
+
+#include "region_marker.h"
+#include <cstdio>
+
+using namespace std;
+
+RegionMarker::RegionMarker(sc_core::sc_module_name name, const AXISwitch &axi_switch, const sc_core::sc_time &clock_cycle) :
+        Module(name), axi_switch(axi_switch), clock_cycle(clock_cycle), errors(0) {
+    for (unsigned n = 0; n < REGION_COUNT; ++n) {
+        regions[n].open = false;
+        regions[n].start_transactions = 0;
+        regions[n].count = 0;
+        regions[n].min_cycles = regions[n].max_cycles = regions[n].total_cycles = 0;
+        regions[n].total_transactions = 0;
+    }
+    rw_socket.register_b_transport(this, &RegionMarker::b_transport);
+}
+
+void RegionMarker::b_transport(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time) {
+    // Only 32 bit writes to the registers are supported:
+    if (payload.get_byte_enable_ptr() || payload.get_data_length() != 4) {
+        payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    uint32_t *data = (uint32_t*) payload.get_data_ptr();
+
+    if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        // The ISS may run ahead of the SystemC time:
+        sc_core::sc_time now = sc_core::sc_time_stamp() + delay_time;
+        switch (payload.get_address()) {
+        case REGION_BEGIN_OFFSET:
+            begin(*data, now);
+            break;
+        case REGION_END_OFFSET:
+            end(*data, now);
+            break;
+        case REGION_COMPARE_OFFSET:
+            compare(*data >> 16, *data & 0xFFFF);
+            break;
+        default:
+            break;
+        }
+    } else if (payload.get_command() == tlm::TLM_READ_COMMAND)
+        *data = 0;
+
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void RegionMarker::begin(unsigned n, const sc_core::sc_time &now) {
+    if (n >= REGION_COUNT) {
+        ++errors;
+        return;
+    }
+    regions[n].open = true;
+    regions[n].start = now;
+    regions[n].start_transactions = axi_switch.get_transactions();
+}
+
+void RegionMarker::end(unsigned n, const sc_core::sc_time &now) {
+    if (n >= REGION_COUNT || !regions[n].open) {
+        ++errors;
+        return;
+    }
+    Region &r = regions[n];
+    uint64_t cycles = (uint64_t) ((now - r.start) / clock_cycle);
+    if (r.count == 0 || cycles < r.min_cycles)
+        r.min_cycles = cycles;
+    if (cycles > r.max_cycles)
+        r.max_cycles = cycles;
+    r.total_cycles += cycles;
+    r.total_transactions += axi_switch.get_transactions() - r.start_transactions;
+    ++r.count;
+    r.open = false;
+}
+
+void RegionMarker::compare(unsigned a, unsigned b) {
+    if (a >= REGION_COUNT || b >= REGION_COUNT) {
+        ++errors;
+        return;
+    }
+    // It is usually written on every run (multi-run mode):
+    for (unsigned i = 0; i < comparisons.size(); ++i)
+        if (comparisons[i].first == a && comparisons[i].second == b)
+            return;
+    comparisons.push_back(std::make_pair(a, b));
+}
+
+void RegionMarker::report() {
+    bool used = false;
+    for (unsigned n = 0; n < REGION_COUNT; ++n)
+        used = used || regions[n].count;
+    if (!used && !errors)
+        return;
+
+    std::cout << " REGIONS:" << std::endl;
+    printf("  %6s %8s %12s %12s %12s %12s\n", "region", "count", "min cycles", "avg cycles", "max cycles", "avg AXI");
+    for (unsigned n = 0; n < REGION_COUNT; ++n) {
+        const Region &r = regions[n];
+        if (!r.count)
+            continue;
+        printf("  %6u %8u %12llu %12.1f %12llu %12.1f\n", n, r.count, (unsigned long long) r.min_cycles,
+                (double) r.total_cycles / r.count, (unsigned long long) r.max_cycles,
+                (double) r.total_transactions / r.count);
+    }
+    for (unsigned i = 0; i < comparisons.size(); ++i) {
+        const Region &a = regions[comparisons[i].first];
+        const Region &b = regions[comparisons[i].second];
+        if (!a.count || !b.count || !a.total_cycles)
+            continue;
+        printf("  region %u over region %u: %.2fx (avg cycles)\n", comparisons[i].second, comparisons[i].first,
+                ((double) b.total_cycles / b.count) / ((double) a.total_cycles / a.count));
+    }
+    fflush(stdout);
+    if (errors)
+        std::cout << "  " << errors << " wrong region markers (unknown region or end without begin)" << std::endl;
+}
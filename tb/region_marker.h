@@ -0,0 +1,57 @@
+/***********************************************************************
+ * region_marker.h
+ * SystemC module of the region markers of the simulation. It is a TLM
+ * target on the TLM bus (see SYS_REGION_BASE in mmap.h and sw/region.h)
+ * where the embedded software writes the beginning and the end of its
+ * code regions. Every write is timestamped with the simulation time
+ * and the number of AXI transactions, and at the end of the simulation
+ * the min/avg/max cycles of every region are reported, followed by the
+ * comparisons of regions asked by the software (REGION_COMPARE).
+ */
+
+#ifndef REGION_MARKER_H_
+#define REGION_MARKER_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <libsimsoc/module.hpp>
+#include <vector>
+#include <utility>
+#include "../sw/region.h"
+#include "axi_switch.h"
+
+class RegionMarker: public simsoc::Module {
+public:
+    typedef RegionMarker SC_CURRENT_USER_MODULE;
+    RegionMarker(sc_core::sc_module_name name, const AXISwitch &axi_switch, const sc_core::sc_time &clock_cycle);
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    // Print the statistics of the regions that have been executed:
+    void report();
+
+    tlm_utils::simple_target_socket<RegionMarker> rw_socket;
+
+protected:
+    void begin(unsigned n, const sc_core::sc_time &now);
+    void end(unsigned n, const sc_core::sc_time &now);
+    void compare(unsigned a, unsigned b);
+
+    struct Region {
+        bool open;
+        sc_core::sc_time start; // Time of the last REGION_BEGIN
+        uint64_t start_transactions; // AXI transactions at the last REGION_BEGIN
+        unsigned count; // Number of executions
+        uint64_t min_cycles, max_cycles, total_cycles;
+        uint64_t total_transactions;
+    };
+
+    const AXISwitch &axi_switch;
+    sc_core::sc_time clock_cycle;
+    Region regions[REGION_COUNT];
+    std::vector<std::pair<unsigned, unsigned> > comparisons; // Regions (a, b) to report b/a
+    unsigned errors; // Wrong markers (unknown region, end without begin)
+};
+
+#endif
@@ -0,0 +1,81 @@
+/***********************************************************************
+ * axi_replay.cpp
+ * Replay harness of the AXI transactions recorded by sctop (option
+ * -axi-record, see ../axi_record.h). It runs them on the cycle level
+ * AXI master and AXISlave (with the IP), without the ISS and the
+ * software, and it checks the data read against the recording:
+ *   ./replay/axi_replay <log> [-fast]
+ * With '-fast' the transactions are run back to back, instead of at
+ * their recorded times. It prints the clock cycles of the transactions
+ * in the recording and in the replay, so a change in the timing of the
+ * IP is seen in seconds, and it returns 1 if any data read differs.
+ *
+ * Build it with 'make replay' in the 'tb' directory.
+ */
+
+#include <systemc.h>
+#include <iostream>
+#include <cstring>
+#include "../axi_record.h"
+#include "../sim_stats.h"
+#include "AXIBridgeStructs.h"
+#include "axi_bindings.h"
+#include "axi_lite_master_transaction_model.h"
+#include "axi_replayer.h"
+#include "../../synth/AXISlave.h"
+
+int sc_main(int argc, char *argv[]) {
+    bool fast = (argc == 3 && strcmp(argv[2], "-fast") == 0);
+    if (argc != 2 && !fast) {
+        std::cerr << "Usage: " << argv[0] << " <log recorded with sctop -axi-record> [-fast]" << std::endl;
+        return 2;
+    }
+
+    AXIRecordReader log;
+    if (!log.open(argv[1])) {
+        std::cerr << argv[0] << ": cannot read the AXI log " << argv[1] << std::endl;
+        return 2;
+    }
+
+    sc_time clock_cycle = sc_time((double) log.get_clock_cycle(), SC_PS);
+    sc_clock clk("CLK", clock_cycle);
+    sc_signal<bool> resetn("RESETN");
+    AXI_Signals axiSignals;
+
+    AXIReplayer replayer("AXI_REPLAYER", log, clock_cycle, fast);
+    axi_lite_master_transaction_model axi_master("axi_master");
+    AXISlave axi_slave("axi_slave");
+
+    replayer.clk(clk);
+    replayer.resetn(resetn);
+    bind_axi_driver(replayer, axiSignals);
+
+    // Same connections as in the SubSystem of sctop (see axi_bindings.h):
+    axi_master.m_axi_lite_aclk(clk);
+    axi_master.m_axi_lite_aresetn(resetn);
+    bind_axi_master(axi_master, axiSignals);
+
+    axi_slave.axi_aclk(clk);
+    axi_slave.axi_aresetn(resetn);
+    bind_axi_slave(axi_slave, axiSignals);
+
+    double wall = SimStats::wall_time();
+    sc_start();
+    wall = SimStats::wall_time() - wall;
+
+    uint64_t recorded = replayer.get_recorded_cycles();
+    uint64_t replayed = replayer.get_replayed_cycles();
+    std::cout << "axi_replay (" << (fast ? "fast" : "timing-faithful") << "): "
+            << replayer.get_transactions() << " AXI transactions, "
+            << replayer.get_irqs() << " interrupt requests, "
+            << replayer.get_mismatches() << " read mismatches" << std::endl;
+    std::cout << "  cycles of the transactions: recorded " << recorded << ", replayed " << replayed;
+    if (recorded)
+        std::cout << " (" << (100.0 * ((double) replayed - (double) recorded) / recorded) << " %)";
+    std::cout << std::endl;
+    std::cout << "  simulated cycles: " << (uint64_t) (sc_time_stamp() / clock_cycle)
+            << " (recorded " << (uint64_t) (sc_time((double) replayer.get_recorded_end(), SC_PS) / clock_cycle)
+            << "), wall time " << wall << " s" << std::endl;
+
+    return (replayer.get_mismatches() || replayer.has_timed_out()) ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/***********************************************************************
+ * axi_replayer.cpp
+ * SystemC module of the replay harness. See axi_replayer.h.
+ */
+
+#include "axi_replayer.h"
+#include "../sim_stats.h"
+#include <iostream>
+
+// Mismatches of the data read printed on stderr (the others are only counted):
+static const uint64_t MAX_PRINTED_MISMATCHES = 10;
+
+AXIReplayer::AXIReplayer(sc_module_name name, AXIRecordReader &log, const sc_time &clock_cycle, bool fast) :
+        AXIDriver(name, clock_cycle), log(log), fast(fast), mismatches(0), irqs(0), timed_out(false), recorded_cycles(0), replayed_cycles(0), recorded_end(0) {
+    SC_THREAD(replay);
+}
+
+void AXIReplayer::wait_until(uint64_t time) {
+    sc_time t = sc_time((double) time, SC_PS);
+    if (!fast && t > sc_time_stamp())
+        wait(t - sc_time_stamp());
+}
+
+void AXIReplayer::replay_transaction(const AXIRecordEntry &entry) {
+    sc_time start = sc_time_stamp();
+    bool read = entry.kind == AXIRecordEntry::RECORD_READ;
+    uint32_t data = transaction(read, entry.address, entry.data, 4);
+
+    recorded_cycles += entry.cycles;
+    replayed_cycles += (uint64_t) ((sc_time_stamp() - start) / clk_cycle + 0.5);
+    recorded_end = entry.time + (uint64_t) entry.cycles * (uint64_t) (clk_cycle.to_seconds() * 1e12 + 0.5);
+
+    if (read && data != entry.data) {
+        if (++mismatches <= MAX_PRINTED_MISMATCHES)
+            std::cerr << "axi_replay: read 0x" << std::hex << entry.address << " = 0x" << data
+                    << ", recorded 0x" << entry.data << std::dec << " (transaction " << transactions
+                    << ", " << sc_time_stamp() << ")" << std::endl;
+    }
+}
+
+void AXIReplayer::replay() {
+    go.write(false);
+    reset();
+
+    AXIRecordEntry entry;
+    while (log.read(entry)) {
+        SIM_STATS_ACTIVATION();
+        switch (entry.kind) {
+        case AXIRecordEntry::RECORD_WRITE:
+        case AXIRecordEntry::RECORD_READ:
+            wait_until(entry.time);
+            replay_transaction(entry);
+            break;
+        case AXIRecordEntry::RECORD_IRQ:
+            // Only the rising edges are waited for (the falling ones follow the writes of the software):
+            if (!entry.data)
+                break;
+            ++irqs;
+            if (!interrupt_request.read()) {
+                wait(IRQ_TIMEOUT_CYCLES * clk_cycle, interrupt_request.posedge_event());
+                if (!interrupt_request.read()) {
+                    std::cerr << "axi_replay: timeout waiting for the interrupt request " << irqs << std::endl;
+                    timed_out = true;
+                    sc_stop();
+                    return;
+                }
+            }
+            // The AXIBridge samples the interrupt request on the next clock edge:
+            wait((uint64_t) (sc_time_stamp() / clk_cycle + 1) * clk_cycle - sc_time_stamp());
+            break;
+        case AXIRecordEntry::RECORD_RESET:
+            wait_until(entry.time);
+            reset();
+            break;
+        default:
+            break;
+        }
+    }
+    sc_stop();
+}
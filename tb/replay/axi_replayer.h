@@ -0,0 +1,53 @@
+/***********************************************************************
+ * axi_replayer.h
+ * SystemC module of the replay harness (see axi_replay.cpp). It reads
+ * the log of the AXI transactions recorded by sctop (see
+ * ../axi_record.h) and runs them on the AXI master, like the AXIBridge
+ * does in sctop (see axi_driver.h), checking the data read against the log:
+ *  - timing-faithful mode: every transaction starts at its recorded
+ *    time (or as soon as possible if the IP is slower than in the
+ *    recording), so the replay has the timing of the software,
+ *  - fast mode: every transaction starts as soon as the previous one
+ *    is done.
+ * In both modes a rising edge of the interrupt request in the log is
+ * waited for before the next transactions, like the software does.
+ */
+
+#ifndef AXI_REPLAYER_H_
+#define AXI_REPLAYER_H_
+
+#include <systemc.h>
+#include "../axi_record.h"
+#include "axi_driver.h"
+
+class AXIReplayer: public AXIDriver {
+public:
+    typedef AXIReplayer SC_CURRENT_USER_MODULE;
+    AXIReplayer(sc_module_name name, AXIRecordReader &log, const sc_time &clock_cycle, bool fast);
+
+    // Maximum clock cycles waiting for a recorded interrupt request:
+    static const uint64_t IRQ_TIMEOUT_CYCLES = 10000000;
+
+    uint64_t get_mismatches() const { return mismatches; }
+    uint64_t get_irqs() const { return irqs; }
+    bool has_timed_out() const { return timed_out; }
+    uint64_t get_recorded_cycles() const { return recorded_cycles; } // Cycles of the transactions in the log
+    uint64_t get_replayed_cycles() const { return replayed_cycles; } // Cycles of the same transactions in the replay
+    uint64_t get_recorded_end() const { return recorded_end; } // End of the last transaction in the log (ps)
+
+private:
+    void replay();
+    void replay_transaction(const AXIRecordEntry &entry);
+    void wait_until(uint64_t time);
+
+    AXIRecordReader &log;
+    bool fast;
+    uint64_t mismatches;
+    uint64_t irqs;
+    bool timed_out;
+    uint64_t recorded_cycles;
+    uint64_t replayed_cycles;
+    uint64_t recorded_end;
+};
+
+#endif
@@ -0,0 +1,121 @@
+/***********************************************************************
+ * sampling.cpp
+ * Sampled simulation: untimed IP with periodic detailed windows at
+ * cycle level. See sampling.h.
+ */
+
+#include "sampling.h"
+#include <cmath>
+
+// 0.975 quantile of the Student's t distribution with 'df' degrees of freedom
+// (the windows have few samples, so the normal quantile 1.96 would be too narrow):
+static double t975(uint64_t df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    // Above 30, the value of the lower bound of every range (a slightly wider interval):
+    if (df <= 30)
+        return table[df - 1];
+    if (df <= 40)
+        return 2.042;
+    if (df <= 60)
+        return 2.021;
+    if (df <= 120)
+        return 2.000;
+    if (df <= 1000)
+        return 1.980;
+    return 1.960;
+}
+
+double SamplingController::Sample::ci95() const {
+    if (n < 2)
+        return 0;
+    double m = mean();
+    double var = (sum2 - n * m * m) / (n - 1); // Sample variance
+    return var > 0 ? t975(n - 1) * sqrt(var / n) : 0;
+}
+
+SamplingController::SamplingController(sc_module_name name, AXISwitch &axi_switch, IPModelTLM &ip_model,
+        const sc_time &clock_cycle) :
+        FastForward(name, axi_switch, ip_model), clk_cycle(clock_cycle), period(10), warmup(1), window(2),
+        inferences(0), mode_changed(false), started(false), detailed_inferences(0) {
+}
+
+void SamplingController::set_sampling(unsigned p, unsigned wu, unsigned w) {
+    window = w ? w : 1;
+    warmup = wu;
+    period = p > warmup + window ? p : warmup + window;
+}
+
+AXISwitch::mode SamplingController::mode_of(uint64_t n) const {
+    return (n % period) < period - warmup - window ? AXISwitch::UNTIMED : AXISwitch::PIN_LEVEL;
+}
+
+bool SamplingController::measured(uint64_t n) const {
+    return (n % period) >= period - window;
+}
+
+bool SamplingController::enable() {
+    if (!FastForward::enable())
+        return false;
+    axi_switch.set_mode(mode_of(0));
+    return true;
+}
+
+void SamplingController::switching(AXISwitch::mode from, AXISwitch::mode to) {
+    transfer_state(to);
+    mode_changed = true;
+}
+
+void SamplingController::transaction(const tlm::tlm_generic_payload &payload, AXISwitch::mode m) {
+    // Only the writes to register 0 delimit the inferences:
+    if (payload.get_command() != tlm::TLM_WRITE_COMMAND || payload.get_address() != 0)
+        return;
+    uint32_t data = payload.get_data_length() == 1 ? *payload.get_data_ptr() : *(uint32_t*) payload.get_data_ptr();
+
+    if (data & 0x80) {
+        // Start of the computations:
+        started = true;
+        start_time = sc_time_stamp();
+        return;
+    }
+    if (!started)
+        return;
+
+    // Acknowledge of the interrupt (end of the inference):
+    started = false;
+    if (m == AXISwitch::PIN_LEVEL) {
+        detailed_inferences++;
+        if (measured(inferences)) {
+            latency.add((sc_time_stamp() - start_time) / clk_cycle);
+            // The whole interval since the previous acknowledge ran at cycle level:
+            if (!mode_changed && inferences > 0)
+                span.add((sc_time_stamp() - last_ack) / clk_cycle);
+        }
+    }
+    last_ack = sc_time_stamp();
+    mode_changed = false;
+    inferences++;
+
+    // Mode of the next inference (it is changed at the next safe point):
+    axi_switch.request_mode(mode_of(inferences));
+}
+
+void SamplingController::report() {
+    if (!enabled)
+        return;
+    std::cout << " SAMPLING: " << inferences << " inferences (" << detailed_inferences << " at cycle level, "
+            << latency.n << " measured), period " << period << ", warm-up " << warmup << ", window " << window << std::endl;
+    if (span.n == 0 && latency.n == 0) {
+        std::cout << "  no detailed window was completed" << std::endl;
+        return;
+    }
+    std::cout << "  cycles per inference: " << span.mean() << " +/- " << span.ci95() << " (95% CI, " << span.n << " samples)" << std::endl;
+    std::cout << "  latency per inference: " << latency.mean() << " +/- " << latency.ci95() << " cycles (95% CI, "
+            << latency.n << " samples)" << std::endl;
+    std::cout << "  estimated total cycles of the inferences: " << span.mean() * inferences << " +/- "
+            << span.ci95() * inferences << std::endl;
+    if (span.n < 2 || latency.n < 2)
+        std::cout << "  (too few samples for a confidence interval, use a longer workload or a larger window)" << std::endl;
+}
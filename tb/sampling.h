@@ -0,0 +1,76 @@
+/***********************************************************************
+ * sampling.h
+ * Sampled simulation for very long workloads (e.g. whole datasets). The
+ * inferences of the IP (from a start in register 0 to the next one) are
+ * grouped in periods. In every period, most of the inferences run with
+ * the untimed model of the IP (fast functional mode), then a few run at
+ * cycle level to warm up the AXI path, and the last ones (the detailed
+ * window) run at cycle level and are measured:
+ *
+ *   |<------------------------ period ------------------------>|
+ *   | untimed ...                  | warm-up | detailed window |
+ *
+ * The state of the IP is transferred between the models when the mode
+ * changes (see fast_forward.h). At the end of the simulation, the
+ * cycles per inference and the latency of the inferences are estimated
+ * from the detailed windows, with 95% confidence intervals, and the
+ * total cycles of the workload are extrapolated.
+ *
+ * An inference is delimited by the acknowledge of its interrupt (a
+ * write to register 0 without the start bit), so an interval between
+ * two acknowledges (drain of the outputs, load of the inputs and
+ * computations) runs in a single mode.
+ */
+
+#ifndef SAMPLING_H_
+#define SAMPLING_H_
+
+#include "fast_forward.h"
+
+class SamplingController: public FastForward {
+public:
+    SamplingController(sc_module_name name, AXISwitch &axi_switch, IPModelTLM &ip_model, const sc_time &clock_cycle);
+
+    // Size (in inferences) of the period, of the warm-up and of the detailed window:
+    void set_sampling(unsigned period, unsigned warmup, unsigned window);
+
+    bool enable();
+    void report();
+
+    /* AXISwitchListener functions: */
+    void switching(AXISwitch::mode from, AXISwitch::mode to);
+    void transaction(const tlm::tlm_generic_payload &payload, AXISwitch::mode m);
+
+private:
+    // Mode of the inference 'n' (counted from 0):
+    AXISwitch::mode mode_of(uint64_t n) const;
+    bool measured(uint64_t n) const;
+
+    // Mean and half width of the 95% confidence interval of a sample:
+    struct Sample {
+        uint64_t n;
+        double sum;
+        double sum2;
+        Sample() : n(0), sum(0), sum2(0) {}
+        void add(double x) { n++; sum += x; sum2 += x * x; }
+        double mean() const { return n ? sum / n : 0; }
+        double ci95() const;
+    };
+
+    sc_time clk_cycle;
+    unsigned period;
+    unsigned warmup;
+    unsigned window;
+
+    uint64_t inferences; // Acknowledged inferences
+    bool mode_changed; // The mode has changed since the last acknowledge
+    bool started; // The current inference has been started
+    sc_time start_time; // Start of the current inference
+    sc_time last_ack; // Acknowledge of the previous inference
+    uint64_t detailed_inferences;
+
+    Sample span; // Cycles between two acknowledges (cycles per inference)
+    Sample latency; // Cycles from the start to the acknowledge of an inference
+};
+
+#endif
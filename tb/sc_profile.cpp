@@ -0,0 +1,96 @@
+/***********************************************************************
+ * sc_profile.cpp
+ * Opt-in profiler of the SystemC processes of the model. See
+ * sc_profile.h.
+ */
+
+#include "sc_profile.h"
+
+#ifdef SC_PROFILE
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <time.h>
+
+namespace {
+
+struct ProcessProfile {
+    const char *name;
+    uint64_t activations;
+    uint64_t host_ns; // Accumulated host time
+    uint64_t start_ns; // Host time of the current activation (0 if it is not running)
+    ProcessProfile() : name(""), activations(0), host_ns(0), start_ns(0) {}
+};
+
+typedef std::map<const sc_core::sc_object*, ProcessProfile> ProfileMap;
+
+ProfileMap &profiles() {
+    static ProfileMap map;
+    return map;
+}
+
+inline uint64_t host_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+ProcessProfile *current() {
+    sc_core::sc_object *process = sc_core::sc_get_current_process_handle().get_process_object();
+    if (!process)
+        return NULL;
+    ProcessProfile &p = profiles()[process];
+    p.name = process->name();
+    return &p;
+}
+
+bool by_host_time(const ProcessProfile *a, const ProcessProfile *b) {
+    return a->host_ns > b->host_ns;
+}
+
+}
+
+void ScProfiler::resume() {
+    ProcessProfile *p = current();
+    if (p) {
+        p->activations++;
+        p->start_ns = host_ns();
+    }
+}
+
+void ScProfiler::suspend() {
+    ProcessProfile *p = current();
+    if (p && p->start_ns) {
+        p->host_ns += host_ns() - p->start_ns;
+        p->start_ns = 0;
+    }
+}
+
+void ScProfiler::report(std::ostream &os) {
+    std::vector<const ProcessProfile*> table;
+    uint64_t total_ns = 0;
+    for (ProfileMap::const_iterator i = profiles().begin(); i != profiles().end(); ++i) {
+        table.push_back(&i->second);
+        total_ns += i->second.host_ns;
+    }
+    std::sort(table.begin(), table.end(), by_host_time);
+
+    char line[256];
+    os << " PROCESS PROFILE (host time of the instrumented processes):" << std::endl;
+    snprintf(line, sizeof(line), "  %-60s %12s %12s %7s %10s", "process", "activations", "host ms", "%", "ns/act");
+    os << line << std::endl;
+    for (unsigned i = 0; i < table.size(); i++) {
+        const ProcessProfile *p = table[i];
+        snprintf(line, sizeof(line), "  %-60s %12llu %12.3f %6.1f%% %10.1f", p->name,
+                (unsigned long long) p->activations, p->host_ns / 1e6,
+                total_ns ? 100.0 * p->host_ns / total_ns : 0.0,
+                p->activations ? (double) p->host_ns / p->activations : 0.0);
+        os << line << std::endl;
+    }
+    snprintf(line, sizeof(line), "  %-60s %12s %12.3f", "total", "", total_ns / 1e6);
+    os << line << std::endl;
+}
+
+#endif
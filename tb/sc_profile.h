@@ -0,0 +1,62 @@
+/***********************************************************************
+ * sc_profile.h
+ * Opt-in profiler of the SystemC processes of the model. It counts the
+ * activations and accumulates the host time of every instrumented
+ * process, and prints a table sorted by host time at the end of the
+ * simulation. It is compiled only with -DSC_PROFILE ('make PROFILE=1');
+ * otherwise the macros below are empty.
+ *
+ * Instrumentation:
+ *  - SC_METHODs: SC_PROFILE_METHOD() at the beginning of the method.
+ *  - SC_THREADs and SC_CTHREADs: the module defines wait() wrappers
+ *    that call ScProfiler::suspend() and ScProfiler::resume() around
+ *    the wait of the kernel (see SC_PROFILE_WAIT_WRAPPERS).
+ * The processes that are not instrumented (e.g. the ISS) do not appear.
+ */
+
+#ifndef SC_PROFILE_H_
+#define SC_PROFILE_H_
+
+#ifdef SC_PROFILE
+
+#include <systemc.h>
+
+class ScProfiler {
+public:
+    // The current process starts (or resumes) running:
+    static void resume();
+    // The current process stops running (it returns or waits):
+    static void suspend();
+    // Print the table of the processes:
+    static void report(std::ostream &os);
+};
+
+// Profile the current activation of an SC_METHOD (until the end of the scope):
+class ScProfileScope {
+public:
+    ScProfileScope() { ScProfiler::resume(); }
+    ~ScProfileScope() { ScProfiler::suspend(); }
+};
+
+#define SC_PROFILE_METHOD()  ScProfileScope sc_profile_scope
+// Hooks for other wait() wrappers (see SIM_STATS_WAIT_WRAPPERS in sim_stats.h):
+#define SC_PROFILE_SUSPEND()  ScProfiler::suspend()
+#define SC_PROFILE_RESUME()   ScProfiler::resume()
+
+// wait() wrappers of a module, to profile its threads. Place it in the declaration of the module:
+#define SC_PROFILE_WAIT_WRAPPERS \
+    void wait() { ScProfiler::suspend(); ::sc_core::wait(); ScProfiler::resume(); } \
+    void wait(int n) { ScProfiler::suspend(); ::sc_core::wait(n); ScProfiler::resume(); } \
+    void wait(const sc_core::sc_event &e) { ScProfiler::suspend(); ::sc_core::wait(e); ScProfiler::resume(); } \
+    void wait(const sc_core::sc_time &t) { ScProfiler::suspend(); ::sc_core::wait(t); ScProfiler::resume(); }
+
+#else
+
+#define SC_PROFILE_METHOD()
+#define SC_PROFILE_SUSPEND()
+#define SC_PROFILE_RESUME()
+#define SC_PROFILE_WAIT_WRAPPERS
+
+#endif
+
+#endif
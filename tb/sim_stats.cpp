@@ -0,0 +1,78 @@
+/***********************************************************************
+ * sim_stats.cpp
+ * Counters of the SystemC simulation itself (not of the simulated
+ * system), used to measure the performance of sctop (see bench.sh).
+ * The results are written as JSON when the '-stats' option is given.
+ */
+
+#include "sim_stats.h"
+#include <cstdio>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+uint64_t SimStats::activations = 0;
+uint64_t SimStats::axi_writes = 0;
+uint64_t SimStats::axi_reads = 0;
+uint64_t SimStats::irqs = 0;
+
+double SimStats::wall_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+long SimStats::peak_rss() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // In bytes on Mac OS X
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// Write 's' as a JSON string (with the quotes):
+static void write_json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char) *s;
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+bool SimStats::write_json(const char *file_name, const char *name, double wall, const sc_time &clock_cycle) {
+    FILE *f = fopen(file_name, "w");
+    if (!f) {
+        std::cerr << "Cannot open the statistics file " << file_name << std::endl;
+        return false;
+    }
+
+    uint64_t cycles = (uint64_t) (sc_time_stamp() / clock_cycle);
+    double khz = wall > 0 ? cycles / wall / 1e3 : 0;
+
+    // One member per line, so the file is easy to process with line-based tools (see bench.sh):
+    fprintf(f, "{\n");
+    fprintf(f, "  \"name\": ");
+    write_json_string(f, name);
+    fprintf(f, ",\n");
+    fprintf(f, "  \"wall_time_s\": %.6f,\n", wall);
+    fprintf(f, "  \"sim_cycles\": %llu,\n", (unsigned long long) cycles);
+    fprintf(f, "  \"sim_khz\": %.3f,\n", khz);
+    fprintf(f, "  \"delta_cycles\": %llu,\n", (unsigned long long) sc_delta_count());
+    fprintf(f, "  \"activations\": %llu,\n", (unsigned long long) activations);
+    fprintf(f, "  \"axi_writes\": %llu,\n", (unsigned long long) axi_writes);
+    fprintf(f, "  \"axi_reads\": %llu,\n", (unsigned long long) axi_reads);
+    fprintf(f, "  \"irqs\": %llu,\n", (unsigned long long) irqs);
+    fprintf(f, "  \"peak_rss_kb\": %ld\n", peak_rss());
+    fprintf(f, "}\n");
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,47 @@
+/***********************************************************************
+ * sim_stats.h
+ * Counters of the SystemC simulation itself (not of the simulated
+ * system), used to measure the performance of sctop (see bench.sh).
+ * The results are written as JSON when the '-stats' option is given.
+ */
+
+#ifndef SIM_STATS_H_
+#define SIM_STATS_H_
+
+#include <inttypes.h>
+#include <systemc.h>
+#include "sc_profile.h"
+
+struct SimStats {
+    static uint64_t activations; // Activations of the instrumented processes (see SIM_STATS_ACTIVATION)
+    static uint64_t axi_writes; // Write transactions through the AXI bridge
+    static uint64_t axi_reads; // Read transactions through the AXI bridge
+    static uint64_t irqs; // Rising edges of the interrupt requests of the AXI IPs
+
+    // Wall clock time (in seconds) since an arbitrary origin:
+    static double wall_time();
+    // Peak resident set size of the process (in kB):
+    static long peak_rss();
+
+    // Write the statistics of the simulation as a JSON object on 'file_name':
+    //   name: name of the scenario
+    //   wall: wall clock time of the simulation (sc_start) in seconds
+    //   clock_cycle: period of the system clock
+    static bool write_json(const char *file_name, const char *name, double wall, const sc_time &clock_cycle);
+};
+
+// Count one activation of the calling process. Place it at the beginning
+// of the SC_METHODs and in the loops of the SC_THREADs of the testbench:
+#define SIM_STATS_ACTIVATION()  (++SimStats::activations)
+
+// wait() wrappers of a module of the IP (synth/), whose code is kept free of
+// simulation calls: every return of wait() of its clocked threads counts as an
+// activation. Place it in the declaration of the module (simulation only). They
+// also profile the threads with -DSC_PROFILE, so they replace SC_PROFILE_WAIT_WRAPPERS:
+#define SIM_STATS_WAIT_WRAPPERS \
+    void wait() { SC_PROFILE_SUSPEND(); ::sc_core::wait(); SC_PROFILE_RESUME(); SIM_STATS_ACTIVATION(); } \
+    void wait(int n) { SC_PROFILE_SUSPEND(); ::sc_core::wait(n); SC_PROFILE_RESUME(); SIM_STATS_ACTIVATION(); } \
+    void wait(const sc_core::sc_event &e) { SC_PROFILE_SUSPEND(); ::sc_core::wait(e); SC_PROFILE_RESUME(); SIM_STATS_ACTIVATION(); } \
+    void wait(const sc_core::sc_time &t) { SC_PROFILE_SUSPEND(); ::sc_core::wait(t); SC_PROFILE_RESUME(); SIM_STATS_ACTIVATION(); }
+
+#endif
@@ -0,0 +1,222 @@
+/***********************************************************************
+ * sparse_memory.cpp
+ * TLM memory with lazy allocation. See sparse_memory.h.
+ */
+
+#include "sparse_memory.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+using namespace simsoc;
+
+SparseMemory::SparseMemory(sc_core::sc_module_name name, uint32_t size, uint32_t page_size) :
+        Module(name), size(size), page_size(page_size), page_shift(0), allocated_pages(0) {
+    while ((1u << page_shift) < page_size)
+        ++page_shift;
+    this->page_size = 1u << page_shift;
+    pages.resize(((uint64_t) size + this->page_size - 1) >> page_shift, (unsigned char*) NULL);
+
+    rw_socket.register_b_transport(this, &SparseMemory::b_transport);
+    rw_socket.register_get_direct_mem_ptr(this, &SparseMemory::get_direct_mem_ptr);
+    rw_socket.register_transport_dbg(this, &SparseMemory::transport_dbg);
+}
+
+SparseMemory::~SparseMemory() {
+    for (unsigned i = 0; i < pages.size(); ++i)
+        free(pages[i]);
+}
+
+unsigned char *SparseMemory::page(uint32_t address) {
+    unsigned char *&p = pages[address >> page_shift];
+    if (!p) {
+        p = (unsigned char*) calloc(page_size, 1);
+        if (!p) {
+            SC_REPORT_FATAL(name(), "cannot allocate a memory page");
+            return NULL;
+        }
+        ++allocated_pages;
+    }
+    return p;
+}
+
+void SparseMemory::read(uint32_t address, unsigned char *data, uint32_t length) {
+    while (length) {
+        uint32_t offset = address & (page_size - 1);
+        uint32_t n = min(length, page_size - offset);
+        const unsigned char *p = pages[address >> page_shift];
+        if (p)
+            memcpy(data, p + offset, n);
+        else
+            memset(data, 0, n); // Untouched page
+        address += n;
+        data += n;
+        length -= n;
+    }
+}
+
+void SparseMemory::write(uint32_t address, const unsigned char *data, uint32_t length) {
+    while (length) {
+        uint32_t offset = address & (page_size - 1);
+        uint32_t n = min(length, page_size - offset);
+        memcpy(page(address) + offset, data, n);
+        address += n;
+        data += n;
+        length -= n;
+    }
+}
+
+void SparseMemory::clear() {
+    for (unsigned i = 0; i < pages.size(); ++i)
+        if (pages[i])
+            memset(pages[i], 0, page_size);
+}
+
+void SparseMemory::b_transport(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time) {
+    uint64_t address = payload.get_address();
+    uint32_t length = payload.get_data_length();
+    if (address + length > size) {
+        payload.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        return;
+    }
+    // A streaming width of 0 (or at least the length) is a non-streaming transaction:
+    uint32_t streaming_width = payload.get_streaming_width();
+    if (streaming_width && streaming_width < length) {
+        payload.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+        return;
+    }
+
+    unsigned char *data = payload.get_data_ptr();
+    const unsigned char *byte_enable = payload.get_byte_enable_ptr();
+    uint32_t byte_enable_length = payload.get_byte_enable_length();
+    if (byte_enable) {
+        // Byte by byte, only the enabled ones (the pattern is repeated if it is shorter than the data).
+        // The disabled bytes are left untouched, in the memory and in the data of a read:
+        for (uint32_t i = 0; i < length; ++i)
+            if (byte_enable_length && byte_enable[i % byte_enable_length]) {
+                if (payload.get_command() == tlm::TLM_READ_COMMAND)
+                    read(address + i, data + i, 1);
+                else if (payload.get_command() == tlm::TLM_WRITE_COMMAND)
+                    write(address + i, data + i, 1);
+            }
+    } else if (payload.get_command() == tlm::TLM_READ_COMMAND) {
+        read(address, data, length);
+    } else if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        write(address, data, length);
+    }
+
+    payload.set_dmi_allowed(true);
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+bool SparseMemory::get_direct_mem_ptr(tlm::tlm_generic_payload &payload, tlm::tlm_dmi &dmi) {
+    uint64_t address = payload.get_address();
+    if (address >= size)
+        return false;
+
+    // One page per DMI region (the pages are not contiguous):
+    uint32_t start = (uint32_t) address & ~(page_size - 1);
+    uint64_t end = min((uint64_t) start + page_size, (uint64_t) size) - 1;
+    dmi.set_dmi_ptr(page(start));
+    dmi.set_start_address(start);
+    dmi.set_end_address(end);
+    dmi.set_granted_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
+    dmi.set_read_latency(sc_core::SC_ZERO_TIME);
+    dmi.set_write_latency(sc_core::SC_ZERO_TIME);
+    return true;
+}
+
+unsigned SparseMemory::transport_dbg(tlm::tlm_generic_payload &payload) {
+    uint64_t address = payload.get_address();
+    if (address >= size)
+        return 0;
+    uint32_t length = (uint32_t) min((uint64_t) payload.get_data_length(), size - address);
+    if (payload.get_command() == tlm::TLM_READ_COMMAND)
+        read(address, payload.get_data_ptr(), length);
+    else if (payload.get_command() == tlm::TLM_WRITE_COMMAND)
+        write(address, payload.get_data_ptr(), length);
+    return length;
+}
+
+void SparseMemory::read_file(const char *file_name, uint32_t address, conv_format type) {
+    ifstream file(file_name);
+    if (!file) {
+        std::cerr << name() << ": cannot open the file " << file_name << std::endl;
+        return;
+    }
+
+    if (type == CHAR2BYTE) {
+        char c;
+        while (address < size && file.get(c)) {
+            write(address, (const unsigned char*) &c, 1);
+            ++address;
+        }
+        return;
+    }
+
+    while (address + 4 <= size) {
+        uint32_t word;
+        if (type == STR2INT) {
+            int32_t v;
+            if (!(file >> v))
+                break;
+            word = (uint32_t) v;
+        } else if (type == STR2UINT) {
+            if (!(file >> word))
+                break;
+        } else if (type == STR2FLOAT) {
+            float v;
+            if (!(file >> v))
+                break;
+            memcpy(&word, &v, 4);
+        } else {
+            std::cerr << name() << ": wrong conversion format to read the file " << file_name << std::endl;
+            return;
+        }
+        write(address, (const unsigned char*) &word, 4);
+        address += 4;
+    }
+}
+
+void SparseMemory::write_file(const char *file_name, uint32_t address, uint32_t elem, uint32_t bits, conv_format type) {
+    ofstream file(file_name);
+    if (!file) {
+        std::cerr << name() << ": cannot open the file " << file_name << std::endl;
+        return;
+    }
+
+    if (type == BYTE2CHAR) {
+        for (uint32_t i = 0; i < elem && address < size; ++i, ++address) {
+            char c;
+            read(address, (unsigned char*) &c, 1);
+            file.put(c);
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < elem && address + 4 <= size; ++i, address += 4) {
+        uint32_t word;
+        read(address, (unsigned char*) &word, 4);
+        if (type == INT2STR) {
+            file << (int32_t) word << std::endl;
+        } else if (type == UINT2STR) {
+            file << word << std::endl;
+        } else if (type == FLOAT2STR) {
+            float v;
+            memcpy(&v, &word, 4);
+            file << v << std::endl;
+        } else {
+            std::cerr << name() << ": wrong conversion format to write the file " << file_name << std::endl;
+            return;
+        }
+    }
+}
+
+void SparseMemory::dump(uint32_t address, uint32_t n, std::ostream &os) {
+    for (uint32_t i = 0; i < n && address + 4 <= size; ++i, address += 4) {
+        uint32_t word;
+        read(address, (unsigned char*) &word, 4);
+        os << std::hex << "0x" << address << ": 0x" << word << std::dec << std::endl;
+    }
+}
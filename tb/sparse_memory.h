@@ -0,0 +1,73 @@
+/***********************************************************************
+ * sparse_memory.h
+ * TLM memory with lazy allocation. The memory is split in pages that
+ * are only allocated (and zero-filled) when they are first written or
+ * given through DMI, so a large address space (e.g. the processor's
+ * RAM, SYS_MEM_SIZE) costs neither start up time nor resident memory
+ * unless it is used. Reads of pages that have never been touched
+ * return zeros.
+ *
+ * It is a replacement of the SimSoC Memory module: it has the same
+ * TLM socket (with DMI, one page per DMI region, and debug transport)
+ * and the same read_file/write_file functions and conversion formats
+ * to load and save the files mapped on memory.
+ */
+
+#ifndef SPARSE_MEMORY_H_
+#define SPARSE_MEMORY_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <libsimsoc/module.hpp>
+#include <libsimsoc/components/memory.hpp> // conv_format
+#include <inttypes.h>
+#include <iostream>
+#include <vector>
+
+class SparseMemory: public simsoc::Module {
+public:
+    typedef SparseMemory SC_CURRENT_USER_MODULE;
+    // size: size of the memory (in bytes); page_size: allocation unit (a power of 2)
+    SparseMemory(sc_core::sc_module_name name, uint32_t size, uint32_t page_size = 4096);
+    ~SparseMemory();
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload &payload, tlm::tlm_dmi &dmi);
+    unsigned transport_dbg(tlm::tlm_generic_payload &payload);
+
+    /* Files mapped on memory (same formats as the SimSoC Memory): */
+    // Load the file 'file_name' from 'address' (one byte per character with
+    // CHAR2BYTE, one 32 bit word per number with STR2INT, STR2UINT and STR2FLOAT):
+    void read_file(const char *file_name, uint32_t address, simsoc::conv_format type);
+    // Save 'elem' elements from 'address' on the file 'file_name' (characters with
+    // BYTE2CHAR, one number per line with INT2STR, UINT2STR and FLOAT2STR).
+    // 'bits' is not used:
+    void write_file(const char *file_name, uint32_t address, uint32_t elem, uint32_t bits, simsoc::conv_format type);
+    // Print 'n' 32 bit words from 'address':
+    void dump(uint32_t address, uint32_t n, std::ostream &os);
+    // Fill the memory with zeros (e.g. before loading a shorter file). The pages
+    // are kept, so the DMI pointers given to the initiators remain valid:
+    void clear();
+
+    uint32_t get_size() const { return size; }
+    // Memory allocated for the pages (in bytes):
+    uint64_t get_allocated() const { return (uint64_t) allocated_pages * page_size; }
+
+    tlm_utils::simple_target_socket<SparseMemory> rw_socket;
+
+protected:
+    // Copy 'length' bytes between 'data' and the memory at 'address' (the range must be valid):
+    void read(uint32_t address, unsigned char *data, uint32_t length);
+    void write(uint32_t address, const unsigned char *data, uint32_t length);
+    // Page that holds 'address', allocated if needed:
+    unsigned char *page(uint32_t address);
+
+    uint32_t size;
+    uint32_t page_size;
+    unsigned page_shift;
+    std::vector<unsigned char*> pages; // NULL until the page is allocated
+    unsigned allocated_pages;
+};
+
+#endif
@@ -0,0 +1,89 @@
+/***********************************************************************
+ * sysctrl.cpp
+ * SystemC module of the system control block of the simulation. It is
+ * a TLM target on the TLM bus (see SYS_SYSCTRL_BASE in mmap.h and the
+ * register map in sw/sysctrl.h) that lets the embedded software talk
+ * to the testbench.
+ */
+
+#include "sysctrl.h"
+
+using namespace std;
+
+SysCtrl::SysCtrl(sc_core::sc_module_name name) :
+        Module(name), listener(NULL), run_index(0), run_count(1), run_pending(false),
+        wakeup(NULL), sleeps(0), sleep_time(sc_core::SC_ZERO_TIME) {
+    rw_socket.register_b_transport(this, &SysCtrl::b_transport);
+}
+
+void SysCtrl::b_transport(tlm::tlm_generic_payload &payload, sc_core::sc_time &delay_time) {
+    // Only 32 bit accesses to the registers are supported:
+    if (payload.get_byte_enable_ptr() || payload.get_data_length() != 4) {
+        payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    uint32_t *data = (uint32_t*) payload.get_data_ptr();
+
+    if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        switch (payload.get_address()) {
+        case SYSCTRL_RUN_DONE_OFFSET:
+            if (listener)
+                listener->run_finished(run_index);
+            run_pending = (run_index + 1 < run_count);
+            if (run_pending) {
+                ++run_index;
+                if (listener)
+                    listener->run_started(run_index);
+            }
+            break;
+        case SYSCTRL_ROI_BEGIN_OFFSET:
+            if (listener)
+                listener->roi_begin();
+            break;
+        case SYSCTRL_SLEEP_OFFSET:
+            // Called from the ISS thread: the processor is not stepped until an interrupt
+            // is requested. It returns at once if one is already pending (it is masked by
+            // the software, which tests its condition before sleeping). The local time of the
+            // ISS is consumed first, like the time stamps of the timer and the region markers:
+            if (wakeup && delay_time != sc_core::SC_ZERO_TIME) {
+                wait(delay_time);
+                delay_time = sc_core::SC_ZERO_TIME;
+            }
+            if (wakeup && !wakeup->pending()) {
+                sc_core::sc_time start = sc_core::sc_time_stamp();
+                wait(wakeup->event());
+                ++sleeps;
+                sleep_time += sc_core::sc_time_stamp() - start;
+            }
+            break;
+        default:
+            break;
+        }
+    } else if (payload.get_command() == tlm::TLM_READ_COMMAND) {
+        switch (payload.get_address()) {
+        case SYSCTRL_RUN_PENDING_OFFSET:
+            *data = run_pending ? 1 : 0;
+            break;
+        case SYSCTRL_RUN_INDEX_OFFSET:
+            *data = run_index;
+            break;
+        case SYSCTRL_RUN_COUNT_OFFSET:
+            *data = run_count;
+            break;
+        default:
+            *data = 0;
+            break;
+        }
+    }
+
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void SysCtrl::report(const sc_core::sc_time &clock_cycle) {
+    if (sleeps == 0)
+        return;
+    info() << "processor asleep " << sleeps << " times, "
+            << (uint64_t) (sleep_time / clock_cycle) << " cycles ("
+            << sleep_time << ")" << endl;
+}
@@ -0,0 +1,71 @@
+/***********************************************************************
+ * sysctrl.h
+ * SystemC module of the system control block of the simulation. It is
+ * a TLM target on the TLM bus (see SYS_SYSCTRL_BASE in mmap.h and the
+ * register map in sw/sysctrl.h) that lets the embedded software talk
+ * to the testbench.
+ *
+ * Multi-run mode: several inputs are processed in a single simulation,
+ * so the elaboration and the start up of the ISS are paid once. When
+ * the software writes RUN_DONE, the module calls its listener (the
+ * SubSystem) to collect the results of the run and to load the inputs
+ * of the next one.
+ *
+ * Sleep: a write to SLEEP blocks the ISS thread until an interrupt line
+ * of irqc is raised (see irq_wakeup.h), so the idle processor costs no
+ * host time while the simulated time runs until the interrupt.
+ */
+
+#ifndef SYSCTRL_H_
+#define SYSCTRL_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <libsimsoc/module.hpp>
+#include "../sw/sysctrl.h"
+#include "irq_wakeup.h"
+
+/***
+ * Interface of the module that collects the results of every run and
+ * prepares the next one.
+ */
+class SysCtrlListener {
+public:
+    virtual ~SysCtrlListener() {}
+    // Called when the software has finished the run 'run':
+    virtual void run_finished(unsigned run) = 0;
+    // Called (from the ISS thread, so it may wait) to load the inputs of the run 'run':
+    virtual void run_started(unsigned run) = 0;
+    // Called when the software marks the beginning of the region of interest:
+    virtual void roi_begin() = 0;
+};
+
+class SysCtrl: public simsoc::Module {
+public:
+    typedef SysCtrl SC_CURRENT_USER_MODULE;
+    SysCtrl(sc_core::sc_module_name name);
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    void set_listener(SysCtrlListener *l) { listener = l; }
+    void set_run_count(unsigned n) { run_count = n; }
+    unsigned get_run_index() const { return run_index; }
+    unsigned get_run_count() const { return run_count; }
+    void set_wakeup(IrqWakeup *w) { wakeup = w; }
+
+    // Report of the time spent asleep:
+    void report(const sc_core::sc_time &clock_cycle);
+
+    tlm_utils::simple_target_socket<SysCtrl> rw_socket;
+protected:
+    SysCtrlListener *listener;
+    unsigned run_index; // Run being executed by the software
+    unsigned run_count; // Number of runs of the simulation
+    bool run_pending; // The inputs of run_index are loaded and the software has not started it yet
+    IrqWakeup *wakeup;
+    unsigned sleeps; // Writes to SLEEP that blocked the processor
+    sc_core::sc_time sleep_time; // Simulated time spent asleep
+};
+
+#endif
@@ -15,6 +15,11 @@
  */
 
 #include "tb_init.h"
+#include "sim_stats.h"
+#include <cstdio>
+
+// Clock cycles between two checks of the wall clock limits (and of the heartbeat):
+#define MONITOR_CYCLES 10000
 
 void GenReset::initialReset() {
     // Start simulation with an active LOW reset:
@@ -29,16 +34,105 @@ void GenReset::initialReset() {
     reset.write(true);
     std::cout << reset << " " << sc_time_stamp() << std::endl;
 
+    // Serve the reset requests of the testbench (see pulse()):
+    while (true) {
+        wait(reset_request);
+        wait(); // Synchronize with the clock
+        reset.write(false);
+        for (int i = 0; i < 2; ++i) {
+            wait();
+        }
+        reset.write(true);
+        wait(); // Let the reset be released on the modules before going on
+        reset_done.notify();
+    }
+}
+
+void GenReset::pulse() {
+    reset_request.notify();
+    ::sc_core::wait(reset_done);
+}
+
 #ifdef SCSIM_WHATCHDOG
-    // Wait SCSIM_WHATCHDOG number of clock cycles (or better said, synchronization points) and force
+void GenReset::whatchdog() {
+    // Wait for the initial reset to be released:
+    wait(2);
+    // Wait SCSIM_WHATCHDOG number of clock cycles (or better said, synchronization points) and force the end of the simulation:
     wait(SCSIM_WHATCHDOG);
+    reason = "watchdog";
     sc_stop();
+}
 #endif
 
-    // This clock thread is not needed any more on the simulation, so it finish here:
+void GenReset::set_limits(const sc_time &clock_cycle, uint64_t cycles, double wall, double hb) {
+    clk_cycle = clock_cycle;
+    max_cycles = cycles;
+    max_wall = wall;
+    heartbeat = hb;
+}
+
+void GenReset::monitor() {
+    if (max_cycles == 0 && max_wall <= 0 && heartbeat <= 0)
+        return;
+
+    double start = SimStats::wall_time();
+    double last_beat = start;
+    uint64_t last_cycles = 0;
+
+    while (true) {
+        // Wait for the next check (or exactly until the cycle limit):
+        uint64_t cycles = (uint64_t) (sc_time_stamp() / clk_cycle);
+        uint64_t step = MONITOR_CYCLES;
+        if (max_cycles && max_cycles - cycles < step)
+            step = max_cycles - cycles;
+        wait(step * clk_cycle);
+        cycles = (uint64_t) (sc_time_stamp() / clk_cycle);
+
+        double now = SimStats::wall_time();
+        if (heartbeat > 0 && now - last_beat >= heartbeat) {
+            fprintf(stderr, "[heartbeat] sim time %s, %.1f kHz, %llu AXI transactions, %llu inferences\n",
+                    sc_time_stamp().to_string().c_str(), (cycles - last_cycles) / (now - last_beat) / 1e3,
+                    (unsigned long long) (SimStats::axi_reads + SimStats::axi_writes),
+                    (unsigned long long) SimStats::irqs);
+            last_beat = now;
+            last_cycles = cycles;
+        }
+
+        if (max_cycles && cycles >= max_cycles) {
+            reason = "max_cycles";
+            std::cerr << "Simulation stopped: limit of " << max_cycles << " cycles reached" << std::endl;
+            sc_stop();
+            return;
+        }
+        if (max_wall > 0 && now - start >= max_wall) {
+            reason = "max_wall";
+            std::cerr << "Simulation stopped: limit of " << max_wall << " s of wall clock time reached" << std::endl;
+            sc_stop();
+            return;
+        }
+    }
+}
+
+void GenReset::print_summary(double wall) const {
+    uint64_t cycles = (uint64_t) (sc_time_stamp() / clk_cycle);
+    // One line of key=value pairs, easy to parse by the scripts of the simulation farm:
+    fprintf(stderr, "SIMSUMMARY status=%s sim_time_ns=%.0f cycles=%llu wall_s=%.3f khz=%.1f axi_transactions=%llu inferences=%llu\n",
+            reason, sc_time_stamp().to_seconds() * 1e9, (unsigned long long) cycles, wall,
+            wall > 0 ? cycles / wall / 1e3 : 0.0,
+            (unsigned long long) (SimStats::axi_reads + SimStats::axi_writes),
+            (unsigned long long) SimStats::irqs);
 }
 
 GenReset::GenReset(sc_module_name name) :
-reset("Reset") {
-    SC_CTHREAD(initialReset, clk.pos());
+reset("Reset"), clk_cycle(10, SC_NS), max_cycles(0), max_wall(0), heartbeat(0), reason("finished") {
+    // It is a thread (instead of a clock thread) because it also waits for the reset requests:
+    SC_THREAD(initialReset);
+    sensitive << clk.pos();
+    dont_initialize();
+
+#ifdef SCSIM_WHATCHDOG
+    SC_CTHREAD(whatchdog, clk.pos());
+#endif
+
+    SC_THREAD(monitor);
 }
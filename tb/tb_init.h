@@ -4,6 +4,9 @@
  * It may also include a whatchdog to stop the simulation if it gets too
  * long (maybe because a critical event that causes the end of the
  * simulation was missed).
+ * The limits of the simulation (simulated cycles and wall clock time)
+ * and a periodic heartbeat on stderr may also be set at run time (see
+ * set_limits()).
  * 
  * Version 1.0:
  *   Author: unknown
@@ -17,6 +20,7 @@
 #ifndef TB_INIT_H
 #define TB_INIT_H
 #include <systemc.h>
+#include <inttypes.h>
 
 SC_MODULE(GenReset) {
 public:
@@ -25,8 +29,37 @@ public:
 
     typedef GenReset SC_CURRENT_USER_MODULE;
     GenReset(sc_module_name name);
+
+    // Re-assert the reset signal for 2 clock cycles (e.g. between the runs of a multi-run simulation).
+    // It must be called from a thread, because it waits until the reset has been released:
+    void pulse();
+
+    // Runtime watchdog and heartbeat (0 disables each of them):
+    //   max_cycles: stop the simulation after this number of clock cycles
+    //   max_wall: stop the simulation after this wall clock time (in seconds)
+    //   heartbeat: period (in wall clock seconds) of the progress messages on stderr
+    void set_limits(const sc_time &clock_cycle, uint64_t max_cycles, double max_wall, double heartbeat);
+
+    // Reason of the end of the simulation: "finished", "max_cycles", "max_wall" or "watchdog":
+    const char *stop_reason() const { return reason; }
+    // Print a machine-readable summary line of the simulation on stderr:
+    void print_summary(double wall) const;
+
 private:
     void initialReset();
+#ifdef SCSIM_WHATCHDOG
+    void whatchdog();
+#endif
+    void monitor(); // Runtime watchdog and heartbeat thread
+
+    sc_event reset_request;
+    sc_event reset_done;
+
+    sc_time clk_cycle;
+    uint64_t max_cycles;
+    double max_wall;
+    double heartbeat;
+    const char *reason;
 };
 
 #endif
@@ -3,7 +3,10 @@
  * 
  * C function to create the VHDL testbench automatically from the
  * SystemC simulation. It opens the testbench file for writing and
- * writes its "head" (i.e. initial lines).
+ * writes its "head" (i.e. initial lines). The stimulus process of the
+ * VHDL testbench reads the transactions from the vectors file
+ * (tbsrc.vec, written by tr.c). The SystemVerilog testbench declares
+ * the pipelined and self-checking transactions used by tr.c.
  * 
  * Version 1.0:
  *   Author: unknown
@@ -20,12 +23,25 @@
 
 #include<stdio.h>
 FILE *tbsrc;
+FILE *tbvec;
 FILE *tbsv;
 
+#define TBGEN_BUFFER_SIZE (1 << 20)
+
+int tbgen_is_enabled();
+void tbgen_start();
+
 void head()
 {
+    if (!tbgen_is_enabled())
+        return;
+
     tbsrc = fopen("tbsrc.vhd", "w");
+    tbvec = fopen("tbsrc.vec", "w");
     tbsv = fopen("tbsrc.sv", "w");
+    /* Large buffers, the files are written by the thread of tr.c: */
+    setvbuf(tbvec, NULL, _IOFBF, TBGEN_BUFFER_SIZE);
+    setvbuf(tbsv, NULL, _IOFBF, TBGEN_BUFFER_SIZE);
 
     fprintf(tbsrc, "library ieee;\n");
     fprintf(tbsrc, "use ieee.std_logic_1164.all;\n");
@@ -37,6 +53,12 @@ void head()
     fprintf(tbsrc, "use IEEE.std_logic_textio.all;          -- I/O for logic types\n");
     fprintf(tbsrc, "\n");
     fprintf(tbsrc, "entity axi_master_testbench is\n");
+    fprintf(tbsrc, "	generic(\n");
+    fprintf(tbsrc, "		-- Keep the timing of the SystemC simulation between the transactions (vsim -gkeep_timing=true)\n");
+    fprintf(tbsrc, "		-- instead of running them back to back:\n");
+    fprintf(tbsrc, "		keep_timing  : boolean := false;\n");
+    fprintf(tbsrc, "		vectors_file : string  := \"tbsrc.vec\"\n");
+    fprintf(tbsrc, "	);\n");
     fprintf(tbsrc, "end axi_master_testbench;\n");
     fprintf(tbsrc, "\n");
     fprintf(tbsrc, "architecture behaviour of axi_master_testbench is\n");
@@ -181,8 +203,20 @@ void head()
     fprintf(tbsrc, "\n");
     fprintf(tbsrc, "	-- -------------------------------------------\n");
     fprintf(tbsrc, "\n");
+    fprintf(tbsrc, "	-- The transactions of the SystemC simulation are read from the vectors file\n");
+    fprintf(tbsrc, "	-- (see tb/tbsrc/tr.c). Every line is: <op> <address> <data> <cycle>\n");
+    fprintf(tbsrc, "	--   op: 'W' write, 'R' read, 'I' wait for the interrupt request of the IP\n");
+    fprintf(tbsrc, "	--   cycle: clock cycle of the request in the SystemC simulation (from the first one)\n");
     fprintf(tbsrc, "	stimulus : process\n");
-    fprintf(tbsrc, "		variable my_line : line;        -- type 'line' comes from textio\n");
+    fprintf(tbsrc, "		file     vectors  : text open read_mode is vectors_file;\n");
+    fprintf(tbsrc, "		variable my_line  : line;        -- type 'line' comes from textio\n");
+    fprintf(tbsrc, "		variable vec_line : line;\n");
+    fprintf(tbsrc, "		variable op       : character;\n");
+    fprintf(tbsrc, "		variable v_addr   : std_logic_vector(31 downto 0);\n");
+    fprintf(tbsrc, "		variable v_data   : std_logic_vector(31 downto 0);\n");
+    fprintf(tbsrc, "		variable v_cycle  : integer;\n");
+    fprintf(tbsrc, "		variable origin   : time;\n");
+    fprintf(tbsrc, "		variable first    : boolean := true;\n");
     fprintf(tbsrc, "	begin\n");
     fprintf(tbsrc, "		-- set an idle state\n");
     fprintf(tbsrc, "		address    <= x\"00000000\";\n");
@@ -195,6 +229,46 @@ void head()
     fprintf(tbsrc, "		write(my_line, string'(\"Simulation starts\")); -- formatting\n");
     fprintf(tbsrc, "		writeline(output, my_line);     -- write to \"output\"\n");
     fprintf(tbsrc, "\n");
+    fprintf(tbsrc, "		while not endfile(vectors) loop\n");
+    fprintf(tbsrc, "			readline(vectors, vec_line);\n");
+    fprintf(tbsrc, "			read(vec_line, op);\n");
+    fprintf(tbsrc, "			hread(vec_line, v_addr);\n");
+    fprintf(tbsrc, "			hread(vec_line, v_data);\n");
+    fprintf(tbsrc, "			read(vec_line, v_cycle);\n");
+    fprintf(tbsrc, "\n");
+    fprintf(tbsrc, "			if first then\n");
+    fprintf(tbsrc, "				origin := now;\n");
+    fprintf(tbsrc, "				first  := false;\n");
+    fprintf(tbsrc, "			end if;\n");
+    fprintf(tbsrc, "\n");
+    fprintf(tbsrc, "			if op = 'I' then\n");
+    fprintf(tbsrc, "				write(my_line, string'(\"IP starts\")); -- formatting\n");
+    fprintf(tbsrc, "				writeline(output, my_line);     -- write to \"output\"\n");
+    fprintf(tbsrc, "				if interrupt_request /= '1' then\n");
+    fprintf(tbsrc, "					wait until interrupt_request = '1';\n");
+    fprintf(tbsrc, "				end if;\n");
+    fprintf(tbsrc, "				write(my_line, string'(\"IP finished\")); -- formatting\n");
+    fprintf(tbsrc, "				writeline(output, my_line);     -- write to \"output\"\n");
+    fprintf(tbsrc, "			else\n");
+    fprintf(tbsrc, "				if keep_timing and now < origin + v_cycle * axi_aclk_period then\n");
+    fprintf(tbsrc, "					wait for origin + v_cycle * axi_aclk_period - now;\n");
+    fprintf(tbsrc, "				end if;\n");
+    fprintf(tbsrc, "				address    <= v_addr;\n");
+    fprintf(tbsrc, "				write_data <= v_data;\n");
+    fprintf(tbsrc, "				if op = 'R' then\n");
+    fprintf(tbsrc, "					rnw <= '1';\n");
+    fprintf(tbsrc, "				else\n");
+    fprintf(tbsrc, "					rnw <= '0';\n");
+    fprintf(tbsrc, "				end if;\n");
+    fprintf(tbsrc, "				go         <= '1';\n");
+    fprintf(tbsrc, "				wait for axi_aclk_period;\n");
+    fprintf(tbsrc, "				wait until done = '1';\n");
+    fprintf(tbsrc, "				go         <= '0';\n");
+    fprintf(tbsrc, "				wait for axi_aclk_period;\n");
+    fprintf(tbsrc, "			end if;\n");
+    fprintf(tbsrc, "		end loop;\n");
+    fprintf(tbsrc, "		address    <= x\"00000000\";\n");
+    fprintf(tbsrc, "\n");
 
     fprintf(tbsv,"`timescale 1ns / 1ps\n");
     fprintf(tbsv,"\n");
@@ -222,6 +296,58 @@ void head()
     fprintf(tbsv,"	// Declare agent\n");
     fprintf(tbsv,"	design_1_axi_vip_0_0_mst_t      master_agent;\n");
     fprintf(tbsv,"\n");
+    fprintf(tbsv,"	// Statistics of the AXI transactions\n");
+    fprintf(tbsv,"	longint bytes = 0;       // Bytes transferred\n");
+    fprintf(tbsv,"	realtime busy_time = 0;  // Time spent on the transactions\n");
+    fprintf(tbsv,"	int errors = 0;          // Data read different from the SystemC simulation\n");
+    fprintf(tbsv,"	int irqs = 0;\n");
+    fprintf(tbsv,"	realtime irq_time = 0;   // Time from the start of the IP to its interrupt request\n");
+    fprintf(tbsv,"	realtime t0;\n");
+    fprintf(tbsv,"\n");
+    fprintf(tbsv,"	// Writes of data[] on consecutive addresses from addr. All the transactions are\n");
+    fprintf(tbsv,"	// sent before waiting for their responses, so they are pipelined by the VIP\n");
+    fprintf(tbsv,"	task automatic write_seq(input bit [31:0] addr, input bit [31:0] data[]);\n");
+    fprintf(tbsv,"		axi_transaction tr[];\n");
+    fprintf(tbsv,"		realtime start = $realtime;\n");
+    fprintf(tbsv,"		tr = new[data.size()];\n");
+    fprintf(tbsv,"		foreach (data[i]) begin\n");
+    fprintf(tbsv,"			tr[i] = master_agent.wr_driver.create_transaction(\"write\");\n");
+    fprintf(tbsv,"			tr[i].set_write_cmd(addr + 4 * i, XIL_AXI_BURST_TYPE_INCR, 0, 0, XIL_AXI_SIZE_4BYTE);\n");
+    fprintf(tbsv,"			tr[i].set_data_block(data[i]);\n");
+    fprintf(tbsv,"			tr[i].set_driver_return_item_policy(XIL_AXI_PAYLOAD_RETURN);\n");
+    fprintf(tbsv,"			master_agent.wr_driver.send(tr[i]);\n");
+    fprintf(tbsv,"		end\n");
+    fprintf(tbsv,"		foreach (tr[i])\n");
+    fprintf(tbsv,"			master_agent.wr_driver.wait_rsp(tr[i]);\n");
+    fprintf(tbsv,"		bytes += 4 * data.size();\n");
+    fprintf(tbsv,"		busy_time += $realtime - start;\n");
+    fprintf(tbsv,"	endtask\n");
+    fprintf(tbsv,"\n");
+    fprintf(tbsv,"	// Pipelined reads of consecutive addresses from addr, checked against the\n");
+    fprintf(tbsv,"	// data read in the SystemC simulation (expected[])\n");
+    fprintf(tbsv,"	task automatic read_seq(input bit [31:0] addr, input bit [31:0] expected[]);\n");
+    fprintf(tbsv,"		axi_transaction tr[];\n");
+    fprintf(tbsv,"		bit [31:0] data;\n");
+    fprintf(tbsv,"		realtime start = $realtime;\n");
+    fprintf(tbsv,"		tr = new[expected.size()];\n");
+    fprintf(tbsv,"		foreach (expected[i]) begin\n");
+    fprintf(tbsv,"			tr[i] = master_agent.rd_driver.create_transaction(\"read\");\n");
+    fprintf(tbsv,"			tr[i].set_read_cmd(addr + 4 * i, XIL_AXI_BURST_TYPE_INCR, 0, 0, XIL_AXI_SIZE_4BYTE);\n");
+    fprintf(tbsv,"			tr[i].set_driver_return_item_policy(XIL_AXI_PAYLOAD_RETURN);\n");
+    fprintf(tbsv,"			master_agent.rd_driver.send(tr[i]);\n");
+    fprintf(tbsv,"		end\n");
+    fprintf(tbsv,"		foreach (tr[i]) begin\n");
+    fprintf(tbsv,"			master_agent.rd_driver.wait_rsp(tr[i]);\n");
+    fprintf(tbsv,"			data = tr[i].get_data_block();\n");
+    fprintf(tbsv,"			if (data != expected[i]) begin\n");
+    fprintf(tbsv,"				errors++;\n");
+    fprintf(tbsv,"				$error(\"Read 0x%%h = 0x%%h, expected 0x%%h\", addr + 4 * i, data, expected[i]);\n");
+    fprintf(tbsv,"			end\n");
+    fprintf(tbsv,"		end\n");
+    fprintf(tbsv,"		bytes += 4 * expected.size();\n");
+    fprintf(tbsv,"		busy_time += $realtime - start;\n");
+    fprintf(tbsv,"	endtask\n");
+    fprintf(tbsv,"\n");
     fprintf(tbsv,"	initial begin\n");
     fprintf(tbsv,"		//Create an agent\n");
     fprintf(tbsv,"		master_agent = new(\"master vip agent\",DUT.design_1_i.axi_vip_0.inst.IF);\n");
@@ -241,4 +367,6 @@ void head()
     fprintf(tbsv,"\n");
     fprintf(tbsv,"		#20ns\n");
     fprintf(tbsv,"\n");
+
+    tbgen_start();
 }
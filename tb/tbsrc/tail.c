@@ -21,10 +21,18 @@
 #include <stdio.h>
 
 extern FILE *tbsrc;
+extern FILE *tbvec;
 extern FILE *tbsv;
 
+int tbgen_is_enabled();
+void tbgen_stop();
+
 void tail()
 {
+    if (!tbgen_is_enabled())
+        return;
+    tbgen_stop(); /* All the transactions are written */
+
     fprintf (tbsrc, "\n");
     fprintf (tbsrc, "		write(my_line, string'(\"Simulation ends\")); -- formatting\n");
     fprintf (tbsrc, "		writeline(output, my_line);     -- write to \"output\"\n");
@@ -96,9 +104,15 @@ void tail()
     fprintf (tbsrc, "end;\n");
 
     fprintf(tbsv, "\t$display(\"Simulation ends\");\n");
+    fprintf(tbsv, "\t$display(\"Read data mismatches: %%0d\", errors);\n");
+    fprintf(tbsv, "\tif (busy_time > 0)\n");
+    fprintf(tbsv, "\t\t$display(\"AXI bandwidth: %%0d bytes in %%0.1f ns of transactions (%%0.1f MB/s)\", bytes, busy_time, bytes * 1000.0 / busy_time);\n");
+    fprintf(tbsv, "\tif (irqs > 0)\n");
+    fprintf(tbsv, "\t\t$display(\"IRQ latency: %%0d interrupt requests, %%0.1f ns on average\", irqs, irq_time / irqs);\n");
     fprintf(tbsv, "\tend\n");
     fprintf(tbsv, "endmodule\n");
 
     fclose(tbsrc);
+    fclose(tbvec);
     fclose(tbsv);
 }
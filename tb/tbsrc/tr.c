@@ -2,9 +2,25 @@
  * tr.c
  * 
  * C functions to create the VHDL testbench automatically from the
- * SystemC simulation. They use the testbench opened by head.c and write
+ * SystemC simulation. They use the files opened by head.c and write
  * transactions (one function for write transactions and another one for
- * read transactions).
+ * read transactions). The VHDL transactions are lines of the vectors
+ * file (tbsrc.vec), replayed by the stimulus process of tbsrc.vhd, with
+ * the clock cycle of the request so the testbench can keep the timing
+ * of the SystemC simulation. The SystemVerilog transactions on
+ * consecutive addresses are grouped in pipelined VIP transactions, and
+ * the data read are checked against the SystemC simulation.
+ *
+ * The rising edges of the interrupt request seen by the AXIBridge are
+ * also recorded, so the jobs of the rings of the IP (started by the
+ * doorbell, with coalesced interrupts) are waited for like the single
+ * job mode (started by the 0x80 write).
+ *
+ * The functions called by the AXIBridge only push the transaction on a
+ * lock-free ring (one producer, the simulation, and one consumer); the
+ * text is formatted and written, with large buffers, by a background
+ * thread started by head() and stopped by tail(). The generation can
+ * be disabled (sctop -no-tbgen) with tbgen_enable(0) before head().
  * 
  * Version 1.0:
  *   Author: unknown
@@ -20,74 +36,248 @@
  */
 
 #include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 #include "../../sw/mmap.h"
 
-extern FILE *tbsrc;
+extern FILE *tbvec;
 extern FILE *tbsv;
 
-void write_transaction(a, d)
-int a, d;
+/* Clock cycle of the first transaction (the cycles of the vectors file start from it): */
+static long first_cycle = -1;
+
+/* One line of the vectors file read by the stimulus process of the VHDL testbench (see head.c): */
+static void vector(op, a, d, cycle)
+int op, a, d;
+long cycle;
+{
+    if (first_cycle < 0)
+        first_cycle = cycle;
+    fprintf(tbvec, "%c %.8x %.8x %ld\n", op, a, d, cycle - first_cycle);
+}
+
+/* Group of SystemVerilog transactions of the same kind on consecutive
+ * addresses, written as a single pipelined write_seq or read_seq (see
+ * head.c) when the next transaction does not follow it: */
+#define SV_GROUP_MAX 64
+
+static int sv_op = 0; /* 'W', 'R' or 0 if the group is empty */
+static int sv_address;
+static int sv_count = 0;
+static int sv_data[SV_GROUP_MAX]; /* Data to write or data read in the SystemC simulation */
+
+static void flush_sv()
+{
+    int i;
+
+    if (sv_count == 0)
+        return;
+    fprintf(tbsv, "\t%s(32'h%.8x, '{", sv_op == 'W' ? "write_seq" : "read_seq", sv_address);
+    for (i = 0; i < sv_count; i++)
+        fprintf(tbsv, "%s32'h%.8x", i == 0 ? "" : (i % 8 == 0 ? ",\n\t\t" : ", "), sv_data[i]);
+    fprintf(tbsv, "});\n");
+    sv_count = 0;
+    sv_op = 0;
+}
+
+static void sv_transaction(op, a, d)
+int op, a, d;
 {
-    fprintf(tbsrc, "\n");
-    fprintf(tbsrc, "		-- Generate a write transaction \n");
-    fprintf(tbsrc, "		address    <= X\"%.8x\";\n", a);
-    fprintf(tbsrc, "		write_data <= X\"%.8x\";\n", d);
-    fprintf(tbsrc, "		rnw        <= '0';\n");
-    fprintf(tbsrc, "		go         <= '1';\n");
-    fprintf(tbsrc, "		wait for AXI_ACLK_period;\n");
-    fprintf(tbsrc, "		wait until done = '1';\n");
-    fprintf(tbsrc, "		go         <= '0';\n");
-    fprintf(tbsrc, "		wait for AXI_ACLK_period;\n");
-    fprintf(tbsrc, "		address    <= X\"00000000\";\n");
-    fprintf(tbsrc, "\n");
-    fprintf(tbsrc, "		wait for AXI_ACLK_period;\n");
-    fprintf(tbsrc, "		wait for simulation_interval;\n");
-    fprintf(tbsrc, "\n");
+    if (sv_count > 0 && (op != sv_op || a != sv_address + 4 * sv_count || sv_count == SV_GROUP_MAX))
+        flush_sv();
+    if (sv_count == 0)
+    {
+        sv_op = op;
+        sv_address = a;
+    }
+    sv_data[sv_count++] = d;
+}
 
+/* Set when the wait for the next interrupt request has already been
+ * written (single job mode), so its rising edge is not waited twice: */
+static int irq_waited = 0;
+
+static void wait_irq(cycle)
+long cycle;
+{
+    vector('I', 0, 0, cycle);
+
+    flush_sv();
     fprintf(tbsv, "\n");
-    fprintf(tbsv, "\tmaster_agent.AXI4LITE_WRITE_BURST(32'h%.8x,prot,32'h%.8x,resp);\n", a, d);
-    fprintf(tbsv, "\t#20ns\n");
+    fprintf(tbsv, "\t$display(\"IP starts\");\n");
+    fprintf(tbsv, "\tt0 = $realtime;\n");
+    fprintf(tbsv, "\twait (interrupt_request == 1);\n");
+    fprintf(tbsv, "\tirq_time += $realtime - t0;\n");
+    fprintf(tbsv, "\tirqs++;\n");
+    fprintf(tbsv, "\t$display(\"IP finished\");\n");
     fprintf(tbsv, "\n");
+}
+
+static void format_write(a, d, cycle)
+int a, d;
+long cycle;
+{
+    vector('W', a, d, cycle);
+    sv_transaction('W', a, d);
 
     if (a == SYS_AXI_BASE && d == 0x80)
     {
-        fprintf(tbsrc, "		write(my_line, string'(\"IP starts\")); -- formatting\n");
-        fprintf(tbsrc, "		writeline(output, my_line);     -- write to \"output\"\n");
-        fprintf(tbsrc, "\n");
-        fprintf(tbsrc, "		wait until interrupt_request = '1';\n");
-        fprintf(tbsrc, "		write(my_line, string'(\"IP finished\")); -- formatting\n");
-        fprintf(tbsrc, "		writeline(output, my_line);     -- write to \"output\"\n");
-        fprintf(tbsrc, "\n");
-
-        fprintf(tbsv, "\n");
-        fprintf(tbsv, "\t$display(\"IP starts\");\n");
-        fprintf(tbsv, "\twait (interrupt_request == 1);\n");
-        fprintf(tbsv, "\t$display(\"IP finished\");\n");
-        fprintf(tbsv, "\n");
+        wait_irq(cycle);
+        irq_waited = 1;
     }
+}
 
+static void format_read(a, d, cycle)
+int a, d;
+long cycle;
+{
+    vector('R', a, 0, cycle);
+    sv_transaction('R', a, d);
 }
 
-void read_transaction(a)
-int a;
+/* Rising edge of the interrupt request (e.g. the coalesced interrupt of
+ * the jobs of the rings): */
+static void format_irq(cycle)
+long cycle;
 {
-    fprintf(tbsrc, "\n");
-    fprintf(tbsrc, "		-- Generate a read transaction \n");
-    fprintf(tbsrc, "		address    <= X\"%.8x\";\n", a);
-    fprintf(tbsrc, "		write_data <= X\"00000000\";\n");
-    fprintf(tbsrc, "		rnw        <= '1';\n");
-    fprintf(tbsrc, "		go         <= '1';\n");
-    fprintf(tbsrc, "		wait for AXI_ACLK_period;\n");
-    fprintf(tbsrc, "		wait until done = '1';\n");
-    fprintf(tbsrc, "		go         <= '0';\n");
-    fprintf(tbsrc, "		wait for AXI_ACLK_period;\n");
-    fprintf(tbsrc, "		address    <= X\"00000000\";\n");
-    fprintf(tbsrc, "\n");
-    fprintf(tbsrc, "		wait for AXI_ACLK_period;\n");
-    fprintf(tbsrc, "		wait for simulation_interval;\n");
-    fprintf(tbsrc, "\n");
+    if (irq_waited)
+        irq_waited = 0;
+    else
+        wait_irq(cycle);
+}
 
-    fprintf(tbsv, "\n");
-    fprintf(tbsv, "\tmaster_agent.AXI4LITE_READ_BURST(32'h%.8x,prot,data_rd,resp);\n", a);
-    fprintf(tbsv, "\n");
+/* Generation of the testbenches (it can be disabled before head()): */
+static int enabled = 1;
+
+void tbgen_enable(e)
+int e;
+{
+    enabled = e;
+}
+
+int tbgen_is_enabled()
+{
+    return enabled;
+}
+
+/* Ring of the transactions to be written by the background thread: */
+#define RING_SIZE 4096
+
+struct record {
+    int op; /* 'W', 'R' or 'I' */
+    int a, d;
+    long cycle;
+};
+
+static struct record ring[RING_SIZE];
+static volatile unsigned ring_head = 0; /* Next record to push (only written by the simulation) */
+static volatile unsigned ring_tail = 0; /* Next record to pop (only written by the writer thread) */
+static volatile int writer_quit = 0;
+static int writer_running = 0;
+static pthread_t writer;
+
+static void format(r)
+const struct record *r;
+{
+    if (r->op == 'W')
+        format_write(r->a, r->d, r->cycle);
+    else if (r->op == 'I')
+        format_irq(r->cycle);
+    else
+        format_read(r->a, r->d, r->cycle);
+}
+
+static void *writer_thread(arg)
+void *arg;
+{
+    struct record r;
+    int quit;
+
+    while (1)
+    {
+        quit = writer_quit; /* Read before the ring, so no record pushed before the end is lost */
+        __sync_synchronize();
+        if (ring_head == ring_tail)
+        {
+            if (quit)
+                break;
+            usleep(1000); /* Do not take the host core of the simulation while there is nothing to write */
+            continue;
+        }
+        __sync_synchronize(); /* The record is read after it has been published */
+        r = ring[ring_tail % RING_SIZE];
+        __sync_synchronize();
+        ring_tail = ring_tail + 1;
+        format(&r);
+    }
+    return NULL;
+}
+
+static void push(op, a, d, cycle)
+int op, a, d;
+long cycle;
+{
+    struct record r;
+    unsigned h = ring_head;
+
+    r.op = op;
+    r.a = a;
+    r.d = d;
+    r.cycle = cycle;
+    if (!writer_running)
+    {
+        format(&r);
+        return;
+    }
+    while (h - ring_tail == RING_SIZE)
+        sched_yield(); /* The ring is full: let the writer thread run */
+    ring[h % RING_SIZE] = r;
+    __sync_synchronize(); /* The record is written before it is published */
+    ring_head = h + 1;
+}
+
+/* Called by head() once the files are open: */
+void tbgen_start()
+{
+    writer_quit = 0;
+    writer_running = (pthread_create(&writer, NULL, writer_thread, NULL) == 0);
+}
+
+/* Called by tail() before writing the end of the files: */
+void tbgen_stop()
+{
+    if (writer_running)
+    {
+        __sync_synchronize();
+        writer_quit = 1;
+        pthread_join(writer, NULL);
+        writer_running = 0;
+    }
+    flush_sv();
+}
+
+void write_transaction(a, d, cycle)
+int a, d;
+long cycle;
+{
+    if (enabled)
+        push('W', a, d, cycle);
+}
+
+/* Called when the read is done, with the data read (d): */
+void read_transaction(a, d, cycle)
+int a, d;
+long cycle;
+{
+    if (enabled)
+        push('R', a, d, cycle);
+}
+
+/* Called on the rising edges of the interrupt request: */
+void irq_transaction(cycle)
+long cycle;
+{
+    if (enabled)
+        push('I', 0, 0, cycle);
 }
@@ -0,0 +1,113 @@
+/***********************************************************************
+ * timer.cpp
+ * SystemC module of the cycle counter and timer of the simulation. See
+ * timer.h.
+ */
+
+#include "timer.h"
+#include "sim_stats.h"
+
+using namespace std;
+using namespace sc_core;
+
+TimerCounter::TimerCounter(sc_module_name name, const sc_time &clock_cycle) :
+        Module(name), clk_cycle(clock_cycle), deadline(SC_ZERO_TIME),
+        count_hi(0), load(0), ctrl(0), status(0), expirations(0) {
+    rw_socket.register_b_transport(this, &TimerCounter::b_transport);
+    SC_METHOD(expire);
+    sensitive << expire_event;
+    dont_initialize();
+}
+
+void TimerCounter::update_irq() {
+    it_signal = (ctrl & TIMER_CTRL_IRQ_EN) && (status & TIMER_STATUS_EXPIRED);
+}
+
+void TimerCounter::arm(const sc_time &now) {
+    // A period of 0 expires on the next cycle:
+    deadline = now + (load ? load : 1) * clk_cycle;
+    expire_event.cancel();
+    expire_event.notify(deadline > sc_time_stamp() ? deadline - sc_time_stamp() : SC_ZERO_TIME);
+}
+
+void TimerCounter::expire() {
+    SIM_STATS_ACTIVATION();
+    ++expirations;
+    status |= TIMER_STATUS_EXPIRED;
+    update_irq();
+    if (ctrl & TIMER_CTRL_PERIODIC)
+        arm(deadline); // No drift: from the previous expiration
+    else
+        ctrl &= ~TIMER_CTRL_ENABLE;
+}
+
+void TimerCounter::b_transport(tlm::tlm_generic_payload &payload, sc_time &delay_time) {
+    // Only 32 bit accesses to the registers are supported:
+    if (payload.get_byte_enable_ptr() || payload.get_data_length() != 4) {
+        payload.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    uint32_t *data = (uint32_t*) payload.get_data_ptr();
+    // The ISS may run ahead of the SystemC time:
+    sc_time now = sc_time_stamp() + delay_time;
+
+    if (payload.get_command() == tlm::TLM_WRITE_COMMAND) {
+        switch (payload.get_address()) {
+        case TIMER_LOAD_OFFSET:
+            load = *data; // Used from the next (re)start or period
+            break;
+        case TIMER_CTRL_OFFSET:
+            ctrl = *data;
+            if (ctrl & TIMER_CTRL_ENABLE)
+                arm(now);
+            else
+                expire_event.cancel();
+            update_irq();
+            break;
+        case TIMER_STATUS_OFFSET:
+            status &= ~(*data & TIMER_STATUS_EXPIRED);
+            update_irq();
+            break;
+        default:
+            break;
+        }
+    } else if (payload.get_command() == tlm::TLM_READ_COMMAND) {
+        switch (payload.get_address()) {
+        case TIMER_COUNT_LO_OFFSET: {
+            uint64_t cycles = (uint64_t) (now / clk_cycle);
+            count_hi = (uint32_t) (cycles >> 32);
+            *data = (uint32_t) cycles;
+            break;
+        }
+        case TIMER_COUNT_HI_OFFSET:
+            *data = count_hi;
+            break;
+        case TIMER_LOAD_OFFSET:
+            *data = load;
+            break;
+        case TIMER_VALUE_OFFSET:
+            *data = (ctrl & TIMER_CTRL_ENABLE) && deadline > now ? (uint32_t) ((deadline - now) / clk_cycle) : 0;
+            break;
+        case TIMER_CTRL_OFFSET:
+            *data = ctrl;
+            break;
+        case TIMER_STATUS_OFFSET:
+            *data = status;
+            break;
+        case TIMER_CLOCK_HZ_OFFSET:
+            *data = (uint32_t) (sc_time(1, SC_SEC) / clk_cycle + 0.5);
+            break;
+        default:
+            *data = 0;
+            break;
+        }
+    }
+
+    payload.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void TimerCounter::report() {
+    if (expirations)
+        cout << name() << ": " << expirations << " expirations" << endl;
+}
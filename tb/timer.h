@@ -0,0 +1,55 @@
+/***********************************************************************
+ * timer.h
+ * SystemC module of the cycle counter and timer of the simulation. It
+ * is a TLM target on the TLM bus (see SYS_TIMER_BASE in mmap.h and the
+ * register map in sw/timer.h) with an interrupt request.
+ *
+ * The cycle counter is computed from the simulation time when it is
+ * read, so it costs nothing in between. The timer is a single event at
+ * its expiration time: there is no process running on every cycle.
+ */
+
+#ifndef TIMER_H_
+#define TIMER_H_
+
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <libsimsoc/module.hpp>
+#include "irq_wakeup.h"
+#include <libsimsoc/interfaces/tlm_signal.hpp>
+#include "../sw/timer.h"
+
+class TimerCounter: public simsoc::Module {
+public:
+    typedef TimerCounter SC_CURRENT_USER_MODULE;
+    TimerCounter(sc_core::sc_module_name name, const sc_core::sc_time &clock_cycle);
+
+    void b_transport(tlm::tlm_generic_payload &payload,
+            sc_core::sc_time &delay_time);
+
+    // Print the number of expirations of the timer:
+    void report();
+
+    tlm_utils::simple_target_socket<TimerCounter> rw_socket;
+    IrqSignalPort it_signal;
+
+protected:
+    void expire(); // Method triggered by expire_event
+    void arm(const sc_core::sc_time &now); // Next expiration, LOAD cycles after 'now'
+    void update_irq();
+
+    sc_core::sc_time clk_cycle;
+    sc_core::sc_event expire_event;
+    sc_core::sc_time deadline; // Time of the next expiration (if the timer is enabled)
+
+    // Registers:
+    uint32_t count_hi; // Latched by the reads of COUNT_LO
+    uint32_t load;
+    uint32_t ctrl;
+    uint32_t status;
+
+    // Statistics:
+    uint64_t expirations;
+};
+
+#endif
@@ -33,12 +33,36 @@
 #include "libsimsoc/interfaces/tlm.hpp"
 #include "libsimsoc/interfaces/tlm_signal.hpp"
 
+// C++ libraries:
+#include <fstream>
+#include <cstring>
+#include <vector>
+#include <string>
+
 // Libraries of the system to be simulated:
 #include "../sw/app.h"
 #include "../sw/mmap.h"
 #include "tb_init.h"
+#include "sysctrl.h"
+#include "sim_stats.h"
+#include "golden_checker.h"
+#include "ip_model_tlm.h"
+#include "axi_switch.h"
+#include "fast_forward.h"
+#include "sampling.h"
+#include "sc_profile.h"
+#include "trace_json.h"
+#include "axi_trace_monitor.h"
+#include "region_marker.h"
+#include "hw_partition.h"
+#include "idle_gate.h"
+#include "sparse_memory.h"
+#include "axi_record.h"
+#include "dma.h"
+#include "timer.h"
 #include "axi_lite_master_transaction_model.h"
 #include "AXIBridgeStructs.h"
+#include "axi_bindings.h"
 #include "axiBridge.h"
 
 #ifdef __RTL_SIMULATION__
@@ -52,11 +76,13 @@
 #define AXISlave AXISlave_rtl_wrapper
 #else
 #include "../synth/AXISlave.h"
+#define MYIP_BUFFERS_VISIBLE // The buffers of the IP can be accessed by the testbench (e.g. by the golden checker)
 #endif
 
 extern "C" {
     void head(void);
     void tail(void);
+    void tbgen_enable(int e);
 }
 
 // Add your libraries here:
@@ -73,13 +99,60 @@ using namespace simsoc;
 // Choose procesor to be emulated by the ISS:
 ParameterBool arm_v5("ARM processor", "-v5", "Simulate ARMv5 (instead of ARMv6)");
 
+// Multi-run mode: file with the list of the inputs (one file name per line) to be processed in a single simulation:
+ParameterString run_list("Multi-run", "-runs", "File with a list of input files (one per line) to run one after the other", "");
+
+// Performance of the simulation (see bench.sh):
+ParameterString stats_file("Simulation statistics", "-stats", "Write the statistics of the simulation (wall time, cycles, kHz...) as JSON on the given file", "");
+ParameterString stats_name("Simulation statistics", "-stats-name", "Name of the scenario written on the statistics file", "app");
+
+// Runtime watchdog and heartbeat (see GenReset::set_limits):
+ParameterInt max_cycles("Watchdog", "-max-cycles", "Stop the simulation after the given number of clock cycles (0: no limit)", 0);
+ParameterInt max_wall("Watchdog", "-max-wall", "Stop the simulation after the given wall clock seconds (0: no limit)", 0);
+ParameterInt heartbeat("Watchdog", "-heartbeat", "Print the progress of the simulation on stderr every given wall clock seconds (0: never)", 0);
+
+// Check the outputs of the IP against its golden model (see golden_model.h):
+ParameterBool golden_check("Golden model", "-check", "Compare the outputs of the IP with the golden model after every interrupt request");
+
+// Untimed model of the IP (see ip_model_tlm.h) instead of the cycle level AXI bus and IP:
+ParameterBool untimed_ip("Untimed IP", "-untimed", "Use the untimed TLM model of the IP instead of the cycle level AXI bus and IP");
+ParameterInt ip_latency("Untimed IP", "-ip-latency", "Clock cycles from the start of the computations of the untimed IP to its interrupt request", 1);
+
+// Hybrid simulation (see fast_forward.h): untimed IP until a trigger, cycle level IP afterwards:
+ParameterBool fast_forward_mode("Fast-forward", "-fast-forward", "Untimed IP until the software marker SYSCTRL_ROI_BEGIN (or another trigger), cycle level IP afterwards");
+ParameterInt ff_transactions("Fast-forward", "-ff-transactions", "Trigger of the fast-forward mode after the given number of AXI transactions", 0);
+ParameterInt ff_time("Fast-forward", "-ff-time", "Trigger of the fast-forward mode at the given simulation time (in ns)", 0);
+
+// Sampled simulation (see sampling.h): untimed IP with periodic detailed windows at cycle level:
+ParameterBool sampling_mode("Sampling", "-sampling", "Untimed IP with periodic detailed windows at cycle level, and estimation of the cycles");
+ParameterInt sample_period("Sampling", "-sample-period", "Inferences of every sampling period", 10);
+ParameterInt sample_warmup("Sampling", "-sample-warmup", "Inferences at cycle level before every detailed window (not measured)", 1);
+ParameterInt sample_window("Sampling", "-sample-window", "Inferences of every detailed window", 2);
+
+// Idle cycle skipping (see idle_gate.h): the clock of the AXI bus and IP is stopped while they are idle:
+ParameterBool idle_skip("Idle skipping", "-idle-skip", "Stop the clock of the AXI bus and IP while they are idle (same cycle timing, faster simulation)");
+
+// Partitioned simulation (see hw_partition.h): cycle level AXI bus and IP in a separate process:
+ParameterBool partition("Partitioned simulation", "-partition", "Simulate the cycle level AXI bus and IP in a separate process (hwsim) on another host core");
+ParameterInt hw_quantum("Partitioned simulation", "-hw-quantum", "Maximum time difference (in clock cycles) between sctop and hwsim", 100);
+ParameterString hwsim_program("Partitioned simulation", "-hwsim", "Hardware simulator of the partitioned simulation (built with 'make hwsim')", "hwsim/hwsim");
+
+// Timeline of the AXI transactions and the IP (see axi_trace_monitor.h), to be opened with Perfetto or chrome://tracing:
+ParameterString trace_json("Trace", "-trace-json", "Write a timeline of the AXI transactions and the phases of the IP on the given file (Chrome trace JSON)", "");
+
+// Generation of the RTL testbenches (tbsrc.vhd, tbsrc.vec and tbsrc.sv, see tbsrc/tr.c):
+ParameterBool no_tbgen("RTL testbench", "-no-tbgen", "Do not generate the RTL testbenches (tbsrc.vhd, tbsrc.vec and tbsrc.sv)");
+
+// Log of the AXI transactions (see axi_record.h), to be replayed without the ISS by replay/axi_replay:
+ParameterString axi_record("AXI record", "-axi-record", "Write the AXI transactions of the AXI bridge (cycle level IP only) on the given binary file", "");
+
 /****
  * SC_MODULE SubSystem
  * Description: It instantiates and connects the ISS (SimSoC), the TLM bus,
  * an AXI bus bridge and the peripherals connected to the buses.
  * 
  */
-class SubSystem: public Module {
+class SubSystem: public Module, public SysCtrlListener {
 public:
 
     // Memmory map BASE addresses and SIZES (from mmap.h) stored as static constants:
@@ -96,6 +169,16 @@ public:
     static const uint32_t AXI_BASE = SYS_AXI_BASE;
     static const uint32_t AXI_SIZE = SYS_AXI_SIZE;
 
+    static const uint32_t SYSCTRL_BASE = SYS_SYSCTRL_BASE;
+    static const uint32_t SYSCTRL_SIZE = SYS_SYSCTRL_SIZE;
+
+    static const uint32_t REGION_BASE = SYS_REGION_BASE;
+    static const uint32_t REGION_SIZE = SYS_REGION_SIZE;
+    static const uint32_t DMA_BASE = SYS_DMA_BASE;
+    static const uint32_t DMA_SIZE = SYS_DMA_SIZE;
+    static const uint32_t TIMER_BASE = SYS_TIMER_BASE;
+    static const uint32_t TIMER_SIZE = SYS_TIMER_SIZE;
+
     // Instantiate the memory map BASE addresses and SIZES static constants of your peripherals here:
 /*** START OF EDITABLE SECTION ***/
 
@@ -116,20 +199,35 @@ public:
 
     /* Submodules: */
     Bus bus; // TLM bus
-    Memory mem; // Processor's memory
+    SparseMemory mem; // Processor's memory (allocated on first touch)
     DebugConsole cons; // Console
     Irqc irqc;
     Processor *proc; // ISS (SimSoC)
     AXIBridge axiBridge;
     axi_lite_master_transaction_model axi_master;
+    SysCtrl sysctrl; // System control block (multi-run control and sleep of the processor)
+    IrqWakeup irq_wakeup; // Levels of the interrupt lines, to wake up the sleeping processor
+    GoldenChecker golden_checker; // Checks the outputs of the IP against the golden model
+    AXISwitch axi_switch; // Routes the AXI transactions to the AXI bridge or to the untimed model of the IP
+    IPModelTLM *ip_model; // Untimed model of the IP (only with -untimed, -fast-forward or -sampling)
+    FastForward *fast_forward; // Hybrid simulation (untimed IP until a trigger, only with -fast-forward)
+    SamplingController *sampler; // Sampled simulation (untimed IP with periodic detailed windows, only with -sampling)
+    HWPartition *hw_partition; // Cycle level AXI bus and IP in a separate process (only with -partition)
+    IdleClockGate *idle_gate; // Gated clock of the AXI bus and IP (only with -idle-skip)
+    RegionMarker region_marker; // Timing of the code regions marked by the software
+    DMAController dma; // DMA controller (scatter-gather transfers between the memories and the AXI bus)
+    TimerCounter timer; // Cycle counter and timer of the software
+    TraceWriter *trace_writer; // Timeline of the simulation (only with -trace-json)
+    AXITraceMonitor *trace_monitor; // Writes the AXI transactions and the phases of the IP on the timeline
+    AXIRecordWriter *axi_recorder; // Log of the AXI transactions (only with -axi-record)
 
     // Declare yor peripheral modules here:
 /*** START OF EDITABLE SECTION ***/
 
     // Examples of files directly mapped on the TLM bus:
-    Memory rfile_mem; // Memory to be associate to rfile.txt for reading
-    Memory wfile_mem; // Memory to be associate to wfile.out for writing
-    Memory rwnum_mem; // Memory to be associate to rwnum.txt and rwnum.out for reading and writing
+    SparseMemory rfile_mem; // Memory to be associate to rfile.txt for reading
+    SparseMemory wfile_mem; // Memory to be associate to wfile.out for writing
+    SparseMemory rwnum_mem; // Memory to be associate to rwnum.txt and rwnum.out for reading and writing
 
     // Example of an IP connected on the AXI bus:
     // It is connected through the AXISlave interface.
@@ -143,42 +241,163 @@ public:
     sc_in<bool> resetn;
     AXI_Signals axiSignals;
     sc_signal<bool> stb; // ???
+    sc_signal<bool> stopped_clk; // Clock of the local AXI master and slaves when they are simulated by hwsim
+    sc_signal<bool> gated_clk; // Clock of the AXI master and slaves with -idle-skip
+    sc_signal<bool> no_ip_busy; // Always false: busy state of the jobs of an IP that is not visible (see MYIP_BUFFERS_VISIBLE)
+
+    /* Multi-run mode: */
+    GenReset *reset_generator; // Used to reset the AXI IPs between runs
+    sc_time clk_cycle; // Clock period, to report the cycles of every run
+    std::vector<std::string> run_inputs; // Input file of every run (only "rfile.txt" if not in multi-run mode)
+
+    // Results collected for every run:
+    struct RunRecord {
+        sc_time start; // Simulation time when the run was started
+        sc_time end; // Simulation time when the software finished the run
+        bool finished;
+        RunRecord() : finished(false) {}
+    };
+    std::vector<RunRecord> runs;
+
+    bool multi_run() const { return run_inputs.size() > 1; }
+
+    // Bind the clock port of an AXI master or slave (the clock is stopped or gated in some modes):
+    void bind_axi_clock(sc_in<bool> &port) {
+        if (hw_partition && hw_partition->is_enabled())
+            port(stopped_clk);
+        else if (idle_gate && idle_gate->is_enabled())
+            port(gated_clk);
+        else
+            port(clk);
+    }
 
-    /* SC functions: */
-    void start_of_simulation () {
-        std::cout << " PRESTART CALLED" << endl;
+    // Name of an output file of the run 'run'. In multi-run mode the run index is inserted before the extension (e.g. wfile.3.out):
+    std::string run_file(const char *name, unsigned run) const {
+        std::string file(name);
+        if (multi_run()) {
+            std::string::size_type dot = file.rfind('.');
+            char index[16];
+            sprintf(index, ".%u", run);
+            file.insert(dot == std::string::npos ? file.size() : dot, index);
+        }
+        return file;
+    }
 
-        // Read input txt files and associate them to their Memory modules:
+    void set_reset_generator(GenReset *rg) { reset_generator = rg; }
+
+    // Read input txt files and associate them to their Memory modules:
+    void load_inputs(unsigned run) {
 /*** START OF EDITABLE SECTION ***/
 
-        rfile_mem.read_file( "rfile.txt", 0 , CHAR2BYTE); // Example rfile.txt for reading
+        // In multi-run mode, nothing of the previous run must remain (its input may be longer):
+        rfile_mem.clear();
+        wfile_mem.clear();
+
+        rfile_mem.read_file( run_inputs[run].c_str(), 0 , CHAR2BYTE); // Example rfile.txt for reading (or the input of the run in multi-run mode)
         // use the appropiate "conv_format" tag for your file kind from: STR2INT, STR2UINT, STR2FLOAT, CHAR2BYTE
 
         rwnum_mem.read_file( "rwnum.txt", 0 , STR2UINT); // Example rwnum.txt for reading
 
 /*** END OF EDITABLE SECTION ***/
-
-        // Writes the header of the RTL (in VHDL) testbench:
-#ifndef COSIM_SYSTEMC
-        head();
-#endif
     }
 
-    void end_of_simulation () {
-        std::cout << " PRESTOP CALLED" << endl;
-
-        // Write output files with the contents stored on their associated Memory modules:
+    // Write output files with the contents stored on their associated Memory modules:
+    void save_outputs(unsigned run) {
 /*** START OF EDITABLE SECTION ***/
 
         // The function 'write_file' declaration is:
         // void write_file(const char *file_name, uint32_t address, uint32_t elem, uint32_t bits, conv_format type);
         // However, the argument bits is not used, so it may be given whatever integer vale. Be carfeul because in future versions this argument may dissapear or become effective.
-        wfile_mem.write_file( "wfile.out", 0, 12, 0, BYTE2CHAR); // Example wfile.out for writing
+        wfile_mem.write_file( run_file("wfile.out", run).c_str(), 0, WFILE_RAM_SIZE, 0, BYTE2CHAR); // Example wfile.out for writing (the whole memory: the outputs of every image in batch mode)
         // use the appropiate "conv_format" tag for your file kind from: INT2STR, UINT2STR, FLOAT2STR, BYTE2CHAR
 
-        rwnum_mem.write_file( "rwnum.out", 0, SYS_RWNUM_RAM_SIZE, 0, UINT2STR); // Example rwnum.out for writing
+        rwnum_mem.write_file( run_file("rwnum.out", run).c_str(), 0, SYS_RWNUM_RAM_SIZE, 0, UINT2STR); // Example rwnum.out for writing
 
 /*** END OF EDITABLE SECTION ***/
+    }
+
+    /* SysCtrlListener functions (multi-run mode): */
+    void run_finished(unsigned run) {
+        runs[run].end = sc_time_stamp();
+        runs[run].finished = true;
+        save_outputs(run);
+    }
+
+    void run_started(unsigned run) {
+        std::cout << " RUN " << run << ": " << run_inputs[run] << endl;
+        load_inputs(run);
+        // Reset the AXI IPs (and the AXI bridge and master), so every run starts from the same state:
+        if (reset_generator)
+            reset_generator->pulse();
+        runs[run].start = sc_time_stamp();
+    }
+
+    void roi_begin() {
+        if (fast_forward)
+            fast_forward->marker();
+    }
+
+    void print_runs() {
+        std::cout << " MULTI-RUN RESULTS:" << endl;
+        std::cout << "  run\tstart\tend\tcycles\tinput" << endl;
+        for (unsigned i = 0; i < runs.size(); i++) {
+            std::cout << "  " << i << "\t" << runs[i].start << "\t";
+            if (runs[i].finished)
+                std::cout << runs[i].end << "\t" << (uint64_t)((runs[i].end - runs[i].start) / clk_cycle);
+            else
+                std::cout << "-\t-";
+            std::cout << "\t" << run_inputs[i] << endl;
+        }
+    }
+
+    /* SC functions: */
+    void start_of_simulation () {
+        std::cout << " PRESTART CALLED" << endl;
+
+        load_inputs(0);
+        runs[0].start = SC_ZERO_TIME;
+
+        // Writes the header of the RTL (in VHDL) testbench:
+#ifndef COSIM_SYSTEMC
+        head();
+#endif
+    }
+
+    void end_of_simulation () {
+        std::cout << " PRESTOP CALLED" << endl;
+
+        // In multi-run mode the outputs are written at the end of every run, and
+        // those of the last one if it has not finished (e.g. stopped by a limit):
+        if (multi_run()) {
+            unsigned run = sysctrl.get_run_index();
+            if (!runs[run].finished)
+                save_outputs(run);
+            print_runs();
+        } else
+            save_outputs(0);
+
+        golden_checker.report();
+        if (fast_forward)
+            fast_forward->report();
+        if (sampler)
+            sampler->report();
+        region_marker.report();
+        dma.report();
+        timer.report();
+        sysctrl.report(clk_cycle);
+        if (hw_partition)
+            hw_partition->stop();
+        if (idle_gate)
+            idle_gate->report();
+
+        if (trace_monitor) {
+            trace_monitor->finish();
+            trace_writer->close();
+        }
+        if (axi_recorder) {
+            std::cout << "AXI record: " << axi_recorder->get_entries() << " entries written on " << axi_record.get() << endl;
+            axi_recorder->close();
+        }
 
         // Writes the tail of the RTL (in VHDL) testbench:
 #ifndef COSIM_SYSTEMC
@@ -193,7 +412,7 @@ public:
      *   clock_cycle (type sc_time&): reference of ***NOTE: it seems to be the AXI bus clock period***, used to construct/initialize the AXI bridge
      */
     SubSystem(sc_module_name name, StopBox *sb, sc_time &clock_cycle) :
-            Module(name), clk("CLK"), resetn("RESETN"), stb("STB"),
+            Module(name), clk("CLK"), resetn("RESETN"), stb("STB"), reset_generator(NULL), clk_cycle(clock_cycle),
             // module instantiation:
             bus("BUS"),
             mem("MEMORY", MEM_SIZE),
@@ -202,6 +421,20 @@ public:
             proc(NULL), // Initialization of the pointer to the ISS (SimSoC) module, it is not construced yet
             axiBridge("AXIBridge", main_context().is_big_endian(), clock_cycle),
             axi_master("axi_master"),
+            sysctrl("SYSCTRL"),
+            golden_checker("GOLDEN_CHECKER"),
+            axi_switch("AXI_SWITCH"),
+            ip_model(NULL),
+            fast_forward(NULL),
+            sampler(NULL),
+            hw_partition(NULL),
+            idle_gate(NULL),
+            region_marker("REGION_MARKER", axi_switch, clock_cycle),
+            dma("DMA", clock_cycle, AXI_BASE, AXI_SIZE),
+            timer("TIMER", clock_cycle),
+            trace_writer(NULL),
+            trace_monitor(NULL),
+            axi_recorder(NULL),
 #ifdef MTI_SYSTEMC
             axi_slave("axi_slave","work.AXISlave"),
 #else
@@ -218,6 +451,23 @@ public:
 
 /*** END OF EDITABLE SECTION ***/
     {
+        // Read the list of inputs of the multi-run mode:
+        if (!run_list.get().empty()) {
+            std::ifstream list(run_list.get().c_str());
+            std::string line;
+            if (!list)
+                std::cerr << "Cannot open the list of runs " << run_list.get() << endl;
+            while (std::getline(list, line)) {
+                if (!line.empty() && line[0] != '#')
+                    run_inputs.push_back(line);
+            }
+        }
+        if (run_inputs.empty())
+            run_inputs.push_back("rfile.txt");
+        runs.resize(run_inputs.size());
+        sysctrl.set_run_count(run_inputs.size());
+        sysctrl.set_listener(this);
+
         // Construct the ISS (SimSoC) for an ARM v5 or v6:
         if (arm_v5.get())
             proc = new ARM_Processor("ARMv5");
@@ -234,13 +484,156 @@ public:
         proc->get_rw_port()(bus.target_sockets);
 
         axiBridge.it_signal(irqc.in_signals[0]); // Interruption from the AXI bus
+        // irqc.in_signals[1]: interruption from the untimed model of the IP (bound below, if it is instantiated)
+        // irqc.in_signals[2]: interruption from the AXI bus simulated by hwsim (bound below, if it is instantiated)
+        dma.it_signal(irqc.in_signals[3]); // Interruption from the DMA controller (end of a chain)
+        timer.it_signal(irqc.in_signals[4]); // Interruption from the timer
         irqc.out_signal(proc->get_it_port()); // Connect IRQ controler to the processor (ISS SimSoC)
 
+        // The interrupt lines also wake up the processor sleeping in SYSCTRL_SLEEP:
+        axiBridge.it_signal.set_wakeup(&irq_wakeup, 0);
+        dma.it_signal.set_wakeup(&irq_wakeup, 3);
+        timer.it_signal.set_wakeup(&irq_wakeup, 4);
+        sysctrl.set_wakeup(&irq_wakeup);
+
         bus.bind_target(mem.rw_socket, MEM_BASE, MEM_SIZE); // Connects processor's memory to the TLM bus
 
         bus.bind_target(cons.target_socket, CONS_BASE, CONS_SIZE); // Connect the console to the TLM bus
         bus.bind_target(irqc.rw_port, IRQC_BASE, IRQC_SIZE); // Connect IRQ controller to the TLM bus
-        bus.bind_target(axiBridge.rw_socket, AXI_BASE, AXI_SIZE); // Connect the AXI bridge to the TLM bus
+        bus.bind_target(sysctrl.rw_socket, SYSCTRL_BASE, SYSCTRL_SIZE); // Connect the system control block to the TLM bus
+        bus.bind_target(region_marker.rw_socket, REGION_BASE, REGION_SIZE); // Connect the region markers to the TLM bus
+        bus.bind_target(dma.rw_socket, DMA_BASE, DMA_SIZE); // Connect the registers of the DMA controller to the TLM bus
+        dma.bus_socket(bus.target_sockets); // The DMA controller is another initiator of the TLM bus
+        bus.bind_target(timer.rw_socket, TIMER_BASE, TIMER_SIZE); // Connect the cycle counter and timer to the TLM bus
+        // Connect the AXI bridge (or the untimed model of the IP) to the TLM bus:
+        bus.bind_target(axi_switch.rw_socket, AXI_BASE, AXI_SIZE);
+
+        // Partitioned simulation (the local AXI master and slaves are stopped):
+        if (partition.get()) {
+            if (sampling_mode.get() || fast_forward_mode.get() || golden_check.get() || !trace_json.get().empty())
+                std::cerr << "The partitioned simulation cannot be combined with -sampling, -fast-forward, -check or -trace-json, option -partition ignored" << endl;
+            else {
+                hw_partition = new HWPartition("HW_PARTITION", clock_cycle);
+                if (!hw_partition->start(hwsim_program.get().c_str(), "hwsim.link", hw_quantum.get() * clock_cycle))
+                    std::cerr << "Cannot start the hardware simulator, option -partition ignored" << endl;
+            }
+        }
+        if (hw_partition) {
+            // To hwsim, or to the local AXI bridge if it could not be started:
+            axi_switch.pin_socket.bind(hw_partition->rw_socket);
+            hw_partition->local_socket.bind(axiBridge.rw_socket);
+            hw_partition->resetn(resetn);
+            hw_partition->it_signal(irqc.in_signals[2]); // Interruption from the AXI bus simulated by hwsim
+            hw_partition->it_signal.set_wakeup(&irq_wakeup, 2);
+        } else
+            axi_switch.pin_socket.bind(axiBridge.rw_socket);
+        if (untimed_ip.get() || fast_forward_mode.get() || sampling_mode.get()) {
+            ip_model = new IPModelTLM("IP_MODEL", ip_latency.get() * clock_cycle);
+            axi_switch.untimed_socket.bind(ip_model->rw_socket);
+            ip_model->resetn(resetn);
+            ip_model->it_signal(irqc.in_signals[1]); // Interruption from the untimed model of the IP
+            ip_model->it_signal.set_wakeup(&irq_wakeup, 1);
+        }
+        if (untimed_ip.get())
+            axi_switch.set_mode(AXISwitch::UNTIMED);
+
+        // Hybrid and sampled simulation:
+        if (sampling_mode.get()) {
+            sampler = new SamplingController("SAMPLER", axi_switch, *ip_model, clock_cycle);
+            sampler->interrupt_request(axiSignals.interrupt_request);
+#ifdef MYIP_BUFFERS_VISIBLE
+            sampler->set_ip_state(axi_slave.myip_1.registers, 16, axi_slave.myip_1.inbuff, axi_slave.myip_1.outbuff,
+                    axi_slave.myip_1.sq, axi_slave.myip_1.cq);
+#endif
+            sampler->set_sampling(sample_period.get(), sample_warmup.get(), sample_window.get());
+            if (!sampler->enable())
+                std::cerr << "The sampled simulation needs the SystemC model of the IP, option -sampling ignored" << endl;
+            else if (fast_forward_mode.get())
+                std::cerr << "The sampled simulation and the fast-forward mode cannot be combined, option -fast-forward ignored" << endl;
+        } else if (fast_forward_mode.get()) {
+            fast_forward = new FastForward("FAST_FORWARD", axi_switch, *ip_model);
+            fast_forward->interrupt_request(axiSignals.interrupt_request);
+#ifdef MYIP_BUFFERS_VISIBLE
+            fast_forward->set_ip_state(axi_slave.myip_1.registers, 16, axi_slave.myip_1.inbuff, axi_slave.myip_1.outbuff,
+                    axi_slave.myip_1.sq, axi_slave.myip_1.cq);
+#endif
+            if (fast_forward->enable()) {
+                fast_forward->set_transaction_trigger(ff_transactions.get());
+                fast_forward->set_time_trigger(sc_time(ff_time.get(), SC_NS));
+            } else
+                std::cerr << "The fast-forward mode needs the SystemC model of the IP, option -fast-forward ignored" << endl;
+        }
+
+#ifndef COSIM_SYSTEMC
+        tbgen_enable(!no_tbgen.get());
+#endif
+
+        // Log of the AXI transactions of the AXI bridge:
+        if (!axi_record.get().empty()) {
+            if (hw_partition && hw_partition->is_enabled())
+                std::cerr << "The AXI transactions are not recorded in the partitioned simulation, option -axi-record ignored" << endl;
+            else if (untimed_ip.get() || (sampler && sampler->is_enabled()) || (fast_forward && fast_forward->is_enabled()))
+                // The transactions served by the untimed IP would be missing from the log:
+                std::cerr << "The AXI transactions are not recorded with -untimed, -sampling or -fast-forward, option -axi-record ignored" << endl;
+            else {
+                axi_recorder = new AXIRecordWriter();
+                if (axi_recorder->open(axi_record.get().c_str(), clock_cycle))
+                    axiBridge.set_recorder(axi_recorder);
+                else {
+                    std::cerr << "Cannot open the AXI record file " << axi_record.get() << ", option -axi-record ignored" << endl;
+                    delete axi_recorder;
+                    axi_recorder = NULL;
+                }
+            }
+        }
+
+        // Idle cycle skipping (the AXI bus and IP are stopped anyway in the partitioned simulation):
+        if (idle_skip.get() && !(hw_partition && hw_partition->is_enabled())) {
+            idle_gate = new IdleClockGate("IDLE_GATE", clock_cycle);
+            idle_gate->gclk(gated_clk);
+            idle_gate->resetn(resetn);
+            idle_gate->go(axiSignals.go);
+            idle_gate->busy(axiSignals.busy);
+            idle_gate->done(axiSignals.done);
+            idle_gate->arvalid(axiSignals.axi_lite_arvalid);
+            idle_gate->rvalid(axiSignals.axi_lite_rvalid);
+            idle_gate->awvalid(axiSignals.axi_lite_awvalid);
+            idle_gate->wvalid(axiSignals.axi_lite_wvalid);
+            idle_gate->bvalid(axiSignals.axi_lite_bvalid);
+#ifdef MYIP_BUFFERS_VISIBLE
+            idle_gate->ip_busy(axi_slave.myip_1.ring_busy);
+#else
+            idle_gate->ip_busy(no_ip_busy);
+#endif
+            idle_gate->enable(true);
+        }
+
+        // Golden checker of the outputs of the IP:
+        golden_checker.interrupt_request(axiSignals.interrupt_request);
+        bind_axi_clock(golden_checker.clk);
+#ifdef MYIP_BUFFERS_VISIBLE
+        golden_checker.ip_busy(axi_slave.myip_1.ring_busy);
+        golden_checker.set_buffers(axi_slave.myip_1.inbuff, axi_slave.myip_1.outbuff);
+        golden_checker.set_rings(axi_slave.myip_1.registers, axi_slave.myip_1.cq);
+        golden_checker.enable(golden_check.get());
+#else
+        golden_checker.ip_busy(no_ip_busy);
+        if (golden_check.get())
+            std::cerr << "The golden checker needs the SystemC model of the IP, option -check ignored" << endl;
+#endif
+
+        // Timeline of the AXI transactions and the IP:
+        if (!trace_json.get().empty()) {
+            trace_writer = new TraceWriter();
+            if (trace_writer->open(trace_json.get().c_str())) {
+                trace_monitor = new AXITraceMonitor("TRACE_MONITOR", axiSignals, *trace_writer);
+                trace_monitor->clk(clk);
+            } else {
+                std::cerr << "Cannot open the trace file " << trace_json.get() << ", option -trace-json ignored" << endl;
+                delete trace_writer;
+                trace_writer = NULL;
+            }
+        }
 
         // Console initializations:
         cons.set_big_endian(main_context().is_big_endian());
@@ -249,71 +642,21 @@ public:
         //AXI Bridge ports:
         axiBridge.clk(clk);
         axiBridge.resetn(resetn);
-        axiBridge.interrupt_request(axiSignals.interrupt_request);
-        axiBridge.go(axiSignals.go);
-        axiBridge.rnw(axiSignals.rnw);
-        axiBridge.busy(axiSignals.busy);
-        axiBridge.done(axiSignals.done);
-        axiBridge.address(axiSignals.address);
-        axiBridge.write_data(axiSignals.write_data);
-        axiBridge.read_data(axiSignals.read_data);
-
-        //AXI Master ports:
-        axi_master.go(axiSignals.go);
-        axi_master.rnw(axiSignals.rnw);
-        axi_master.busy(axiSignals.busy);
-        axi_master.done(axiSignals.done);
-        axi_master.address(axiSignals.address);
-        axi_master.write_data(axiSignals.write_data);
-        axi_master.read_data(axiSignals.read_data);
-
-        axi_master.m_axi_lite_aclk(clk);
+        bind_axi_driver(axiBridge, axiSignals);
+
+        //AXI Master ports (the same connections as in hwsim and axi_replay, see axi_bindings.h):
+        bind_axi_clock(axi_master.m_axi_lite_aclk);
         axi_master.m_axi_lite_aresetn(resetn);
-        axi_master.m_axi_lite_arready(axiSignals.axi_lite_arready);
-        axi_master.m_axi_lite_arvalid(axiSignals.axi_lite_arvalid);
-        axi_master.m_axi_lite_araddr(axiSignals.axi_lite_araddr);
-        axi_master.m_axi_lite_rready(axiSignals.axi_lite_rready);
-        axi_master.m_axi_lite_rvalid(axiSignals.axi_lite_rvalid);
-        axi_master.m_axi_lite_rdata(axiSignals.axi_lite_rdata);
-        axi_master.m_axi_lite_rresp(axiSignals.axi_lite_rresp);
-        axi_master.m_axi_lite_awready(axiSignals.axi_lite_awready);
-        axi_master.m_axi_lite_awvalid(axiSignals.axi_lite_awvalid);
-        axi_master.m_axi_lite_awaddr(axiSignals.axi_lite_awaddr);
-        axi_master.m_axi_lite_wready(axiSignals.axi_lite_wready);
-        axi_master.m_axi_lite_wvalid(axiSignals.axi_lite_wvalid);
-        axi_master.m_axi_lite_wdata(axiSignals.axi_lite_wdata);
-        axi_master.m_axi_lite_wstrb(axiSignals.axi_lite_wstrb);
-        axi_master.m_axi_lite_bready(axiSignals.axi_lite_bready);
-        axi_master.m_axi_lite_bvalid(axiSignals.axi_lite_bvalid);
-        axi_master.m_axi_lite_bresp(axiSignals.axi_lite_bresp);
+        bind_axi_master(axi_master, axiSignals);
 
         // Initialize and connect/bind your peripherals here:
 /*** START OF EDITABLE SECTION ***/
 
         // You may need to add more AXI slave modules:
         //AXI Slave ports of one AXI slave:
-        axi_slave.axi_aclk(clk);
+        bind_axi_clock(axi_slave.axi_aclk);
         axi_slave.axi_aresetn(resetn);
-        axi_slave.interrupt_request(axiSignals.interrupt_request);
-        axi_slave.s_axi_arready(axiSignals.axi_lite_arready);
-        axi_slave.s_axi_arvalid(axiSignals.axi_lite_arvalid);
-        axi_slave.s_axi_araddr(axiSignals.axi_lite_araddr);
-        axi_slave.s_axi_arprot(axiSignals.axi_lite_arprot);
-        axi_slave.s_axi_rready(axiSignals.axi_lite_rready);
-        axi_slave.s_axi_rvalid(axiSignals.axi_lite_rvalid);
-        axi_slave.s_axi_rdata(axiSignals.axi_lite_rdata);
-        axi_slave.s_axi_rresp(axiSignals.axi_lite_rresp);
-        axi_slave.s_axi_awaddr(axiSignals.axi_lite_awaddr);
-        axi_slave.s_axi_awprot(axiSignals.axi_lite_awprot);
-        axi_slave.s_axi_awvalid(axiSignals.axi_lite_awvalid);
-        axi_slave.s_axi_awready(axiSignals.axi_lite_awready);
-        axi_slave.s_axi_wdata(axiSignals.axi_lite_wdata);
-        axi_slave.s_axi_wstrb(axiSignals.axi_lite_wstrb);
-        axi_slave.s_axi_wvalid(axiSignals.axi_lite_wvalid);
-        axi_slave.s_axi_wready(axiSignals.axi_lite_wready);
-        axi_slave.s_axi_bresp(axiSignals.axi_lite_bresp);
-        axi_slave.s_axi_bvalid(axiSignals.axi_lite_bvalid);
-        axi_slave.s_axi_bready(axiSignals.axi_lite_bready);
+        bind_axi_slave(axi_slave, axiSignals);
 
         // Connect Memory modules associated to files to the TLM bus:
         bus.bind_target(rfile_mem.rw_socket, RFILE_RAM_BASE, RFILE_RAM_SIZE); // Connect the example file to read
@@ -345,6 +688,8 @@ public:
     Top(sc_module_name name, sc_time &clock_cycle) : Module(name), clk("CLK", clock_cycle), sb("STOPBOX", 1), soc0("SOC0", &sb, clock_cycle), resetGenerator( "ResetGenerator") {
         resetGenerator.clk.bind(clk);
         resetGenerator.reset.bind(resetn);
+        soc0.set_reset_generator(&resetGenerator);
+        resetGenerator.set_limits(clock_cycle, max_cycles.get(), max_wall.get(), heartbeat.get());
         soc0.clk.bind(clk);
         soc0.resetn.bind(resetn);
     }
@@ -494,14 +839,25 @@ int sc_main(int argc, char *argv[]) {
     //sc_trace(fp, top.soc0.irqc.in_signals[0], "irqc_in_signals");
 
     /* Start simulation */
+    double wall_start = SimStats::wall_time();
     sc_start();
+    double wall = SimStats::wall_time() - wall_start;
+
+    // Write the statistics of the simulation:
+    if (!stats_file.get().empty())
+        SimStats::write_json(stats_file.get().c_str(), stats_name.get().c_str(), wall, clock_cycle);
+    top.resetGenerator.print_summary(wall);
+#ifdef SC_PROFILE
+    ScProfiler::report(std::cout);
+#endif
 
     /* Cleanup */
     
     // Close trace file:
     sc_close_vcd_trace_file( fp );
 
-    return 0;
+    // A simulation stopped by a limit (not by the software) is an error for the scripts:
+    return strcmp(top.resetGenerator.stop_reason(), "finished") == 0 ? 0 : 2;
 }
 
 #endif
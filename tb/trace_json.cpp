@@ -0,0 +1,56 @@
+/***********************************************************************
+ * trace_json.cpp
+ * Writer of timelines in the Chrome trace event format. See
+ * trace_json.h.
+ */
+
+#include "trace_json.h"
+
+TraceWriter::TraceWriter() :
+        file(NULL), tracks(0) {
+}
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+bool TraceWriter::open(const char *file_name) {
+    file = fopen(file_name, "w");
+    if (!file) {
+        std::cerr << "Cannot open the trace file " << file_name << std::endl;
+        return false;
+    }
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    fprintf(file, "{\"ph\": \"M\", \"pid\": 1, \"name\": \"process_name\", \"args\": {\"name\": \"sctop\"}}");
+    return true;
+}
+
+void TraceWriter::close() {
+    if (!file)
+        return;
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    file = NULL;
+}
+
+int TraceWriter::track(const char *name) {
+    int tid = ++tracks;
+    if (file) {
+        fprintf(file, ",\n{\"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"name\": \"thread_name\", \"args\": {\"name\": \"%s\"}}", tid, name);
+        // Keep the tracks in the order they are declared:
+        fprintf(file, ",\n{\"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"name\": \"thread_sort_index\", \"args\": {\"sort_index\": %d}}", tid, tid);
+    }
+    return tid;
+}
+
+void TraceWriter::slice(int tid, const char *name, const sc_time &start, const sc_time &end, const std::string &args) {
+    if (!file)
+        return;
+    // The times of the trace are in microseconds:
+    double ts = start.to_seconds() * 1e6;
+    double dur = (end - start).to_seconds() * 1e6;
+    fprintf(file, ",\n{\"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"name\": \"%s\", \"ts\": %.3f, \"dur\": %.3f", tid, name, ts, dur);
+    if (!args.empty())
+        fprintf(file, ", \"args\": {%s}", args.c_str());
+    fprintf(file, "}");
+}
@@ -0,0 +1,68 @@
+/***********************************************************************
+ * trace_json.h
+ * Writer of timelines in the Chrome trace event format (JSON), which
+ * can be opened with Perfetto (ui.perfetto.dev) or chrome://tracing.
+ * Every track is a "thread" of the trace and every slice is a complete
+ * ("X") event with its simulation start time and duration.
+ */
+
+#ifndef TRACE_JSON_H_
+#define TRACE_JSON_H_
+
+#include <systemc.h>
+#include <cstdio>
+#include <string>
+
+class TraceWriter {
+public:
+    TraceWriter();
+    ~TraceWriter();
+
+    bool open(const char *file_name);
+    void close();
+    bool is_open() const { return file != NULL; }
+
+    // Declare a track (it returns its identifier):
+    int track(const char *name);
+
+    // Write a slice of the track 'tid' from 'start' to 'end':
+    void slice(int tid, const char *name, const sc_time &start, const sc_time &end, const std::string &args = "");
+
+private:
+    FILE *file;
+    int tracks;
+};
+
+/***
+ * Slice of a track that is opened and closed at different times.
+ */
+class TraceSlice {
+public:
+    TraceSlice() : writer(NULL), tid(0), opened(false) {}
+    void init(TraceWriter *w, int t) { writer = w; tid = t; }
+
+    void begin(const std::string &slice_name, const std::string &slice_args = "") {
+        end();
+        name = slice_name;
+        args = slice_args;
+        start = sc_time_stamp();
+        opened = true;
+    }
+    void end() {
+        if (opened && writer)
+            writer->slice(tid, name.c_str(), start, sc_time_stamp(), args);
+        opened = false;
+    }
+    bool is_open() const { return opened; }
+    const std::string &get_name() const { return name; }
+
+private:
+    TraceWriter *writer;
+    int tid;
+    bool opened;
+    std::string name;
+    std::string args;
+    sc_time start;
+};
+
+#endif